@@ -0,0 +1,84 @@
+description(
+"Tests that selectors with combinators, compound simple selectors and attribute selectors match exactly the elements they should."
+);
+
+var style = document.createElement("style");
+style.textContent =
+    ".outer .descendant, .middle > .child, .outer > .notChild, " +
+    ".first + .adjacent, .first ~ .general, .first + .notAdjacent, " +
+    "[data-a] .attributeDescendant, [data-a=\"v\"], [data-b~=\"two\"], [data-c^=\"pre\"], " +
+    "div.compound#compoundId, .both.classes, p:first-child.firstChild, " +
+    ".backtrackA > .backtrackB .backtrackC, .universal *, .negated:not(.excluded), #idOnly, " +
+    ".tagOuter em { color: green }";
+document.getElementsByTagName("head")[0].appendChild(style);
+
+var container = document.createElement("div");
+container.innerHTML =
+    "<div class='outer'><div class='middle'>" +
+        "<p id='descendant' class='descendant'></p>" +
+        "<p id='child' class='child'></p>" +
+        "<p id='notChild' class='notChild'></p>" +
+    "</div></div>" +
+    "<div>" +
+        "<p class='first'></p><p id='adjacent' class='adjacent'></p><p id='notAdjacent' class='notAdjacent'></p><p id='general' class='general'></p>" +
+    "</div>" +
+    "<div data-a='x'><span><p id='attributeDescendant' class='attributeDescendant'></p></span></div>" +
+    "<p id='attributeEquals' data-a='v'></p>" +
+    "<p id='attributeNotEquals' data-a='vv'></p>" +
+    "<p id='attributeListContains' data-b='one two three'></p>" +
+    "<p id='attributeListMissing' data-b='one twothree'></p>" +
+    "<p id='attributePrefix' data-c='prefix'></p>" +
+    "<p id='attributeNoPrefix' data-c='apre'></p>" +
+    "<div id='compoundId' class='compound'></div>" +
+    "<p id='compoundWrongTag' class='compound'></p>" +
+    "<p id='bothClasses' class='classes both'></p>" +
+    "<p id='oneClass' class='both'></p>" +
+    "<div><p id='firstChild' class='firstChild'></p><p id='notFirstChild' class='firstChild'></p></div>" +
+    "<div class='backtrackA'><div class='backtrackB'><div class='backtrackB'><p id='backtrack' class='backtrackC'></p></div></div></div>" +
+    "<div class='backtrackB'><div class='backtrackA'><div><p id='noBacktrack' class='backtrackC'></p></div></div></div>" +
+    "<div class='universal'><span><b id='universal'></b></span></div>" +
+    "<p id='negated' class='negated'></p>" +
+    "<p id='negatedExcluded' class='negated excluded'></p>" +
+    "<p id='idOnly'></p>" +
+    "<div class='tagOuter'><span><em id='tag'></em><i id='otherTag'></i></span></div>";
+document.body.appendChild(container);
+
+var green = "rgb(0, 128, 0)";
+var black = "rgb(0, 0, 0)";
+
+function colorOf(id)
+{
+    return getComputedStyle(document.getElementById(id), null).color;
+}
+
+shouldBe('colorOf("descendant")', 'green');
+shouldBe('colorOf("child")', 'green');
+shouldBe('colorOf("notChild")', 'black');
+shouldBe('colorOf("adjacent")', 'green');
+shouldBe('colorOf("notAdjacent")', 'black');
+shouldBe('colorOf("general")', 'green');
+shouldBe('colorOf("attributeDescendant")', 'green');
+shouldBe('colorOf("attributeEquals")', 'green');
+shouldBe('colorOf("attributeNotEquals")', 'black');
+shouldBe('colorOf("attributeListContains")', 'green');
+shouldBe('colorOf("attributeListMissing")', 'black');
+shouldBe('colorOf("attributePrefix")', 'green');
+shouldBe('colorOf("attributeNoPrefix")', 'black');
+shouldBe('colorOf("compoundId")', 'green');
+shouldBe('colorOf("compoundWrongTag")', 'black');
+shouldBe('colorOf("bothClasses")', 'green');
+shouldBe('colorOf("oneClass")', 'black');
+shouldBe('colorOf("firstChild")', 'green');
+shouldBe('colorOf("notFirstChild")', 'black');
+shouldBe('colorOf("backtrack")', 'green');
+shouldBe('colorOf("noBacktrack")', 'black');
+shouldBe('colorOf("universal")', 'green');
+shouldBe('colorOf("negated")', 'green');
+shouldBe('colorOf("negatedExcluded")', 'black');
+shouldBe('colorOf("idOnly")', 'green');
+shouldBe('colorOf("tag")', 'green');
+shouldBe('colorOf("otherTag")', 'black');
+
+document.body.removeChild(container);
+
+var successfullyParsed = true;
@@ -0,0 +1,83 @@
+description(
+"Tests that elements matching the same declarations still get their own inherited and relative values, and that changing one of them leaves the others alone."
+);
+
+var style = document.createElement("style");
+style.textContent =
+    ".item { font-weight: bold; width: 2em; }" +
+    ".odd { color: green; }" +
+    ".even { color: blue; }" +
+    ".redParent { color: red; font-size: 10px; }" +
+    ".purpleParent { color: purple; font-size: 20px; }";
+document.getElementsByTagName("head")[0].appendChild(style);
+
+var container = document.createElement("div");
+container.innerHTML =
+    "<div class='redParent'><p id='inRed' class='item'></p></div>" +
+    "<div class='purpleParent'><p id='inPurple' class='item'></p></div>" +
+    "<div id='siblings'></div>";
+document.body.appendChild(container);
+
+// Enough siblings for style resolution to split them between threads when it can.
+var siblingCount = 64;
+var siblings = document.getElementById("siblings");
+for (var i = 0; i < siblingCount; ++i) {
+    var p = document.createElement("p");
+    p.className = i % 2 ? "item odd" : "item even";
+    siblings.appendChild(p);
+}
+
+var green = "rgb(0, 128, 0)";
+var blue = "rgb(0, 0, 255)";
+
+function computedStyle(id)
+{
+    return getComputedStyle(document.getElementById(id), null);
+}
+
+function siblingsWithWrongColor(expectedColor)
+{
+    var wrong = [];
+    for (var i = 0; i < siblingCount; ++i) {
+        if (getComputedStyle(siblings.childNodes[i], null).color != expectedColor(i))
+            wrong.push(i);
+    }
+    return wrong;
+}
+
+function alternating(i)
+{
+    return i % 2 ? green : blue;
+}
+
+function alternatingExceptSeven(i)
+{
+    return i == 7 ? blue : alternating(i);
+}
+
+debug('Inherited and relative values with the same matched declarations');
+shouldBe('computedStyle("inRed").color', '"rgb(255, 0, 0)"');
+shouldBe('computedStyle("inPurple").color', '"rgb(128, 0, 128)"');
+shouldBe('computedStyle("inRed").width', '"20px"');
+shouldBe('computedStyle("inPurple").width', '"40px"');
+shouldBe('computedStyle("inRed").fontWeight', 'computedStyle("inPurple").fontWeight');
+
+debug('');
+debug('Changing the parent after the children were resolved');
+document.getElementById("inRed").parentNode.className = "purpleParent";
+shouldBe('computedStyle("inRed").color', '"rgb(128, 0, 128)"');
+shouldBe('computedStyle("inRed").width', '"40px"');
+
+debug('');
+debug('Siblings');
+shouldBe('siblingsWithWrongColor(alternating)', '[]');
+siblings.childNodes[7].style.color = "blue";
+shouldBe('siblingsWithWrongColor(alternatingExceptSeven)', '[]');
+siblings.childNodes[7].removeAttribute("style");
+shouldBe('siblingsWithWrongColor(alternating)', '[]');
+siblings.childNodes[7].className = "item even";
+shouldBe('siblingsWithWrongColor(alternatingExceptSeven)', '[]');
+
+document.body.removeChild(container);
+
+var successfullyParsed = true;
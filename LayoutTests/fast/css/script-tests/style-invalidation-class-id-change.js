@@ -0,0 +1,89 @@
+description(
+"Tests that changing the class, id or an attribute of an element restyles exactly the elements whose matching rules depend on it."
+);
+
+var style = document.createElement("style");
+style.textContent =
+    ".on .target, .on + .sibling, .on ~ .later, .self.on, #active .idTarget, #activeSelf, " +
+    "[data-state=\"on\"] .attributeTarget { color: green }";
+document.getElementsByTagName("head")[0].appendChild(style);
+
+var container = document.createElement("div");
+container.innerHTML =
+    "<div id='ancestor'><span><p id='target' class='target'></p></span><p id='unrelated'></p></div>" +
+    "<div><p id='previous'></p><p id='sibling' class='sibling'></p><p id='notNext' class='sibling'></p><p id='later' class='later'></p></div>" +
+    "<p id='self' class='self'></p>" +
+    "<div id='idAncestor'><p id='idTarget' class='idTarget'></p></div>" +
+    "<p id='idSelf'></p>" +
+    "<div id='attributeAncestor' data-state='off'><p id='attributeTarget' class='attributeTarget'></p></div>";
+document.body.appendChild(container);
+
+var green = "rgb(0, 128, 0)";
+var black = "rgb(0, 0, 0)";
+
+function colorOf(id)
+{
+    return getComputedStyle(document.getElementById(id), null).color;
+}
+
+function element(id)
+{
+    return document.getElementById(id);
+}
+
+debug('Class change on an ancestor');
+shouldBe('colorOf("target")', 'black');
+element("ancestor").className = "on";
+shouldBe('colorOf("target")', 'green');
+shouldBe('colorOf("unrelated")', 'black');
+element("ancestor").className = "something on else";
+shouldBe('colorOf("target")', 'green');
+element("ancestor").className = "";
+shouldBe('colorOf("target")', 'black');
+
+debug('');
+debug('Class change on a previous sibling');
+shouldBe('colorOf("sibling")', 'black');
+shouldBe('colorOf("later")', 'black');
+element("previous").className = "on";
+shouldBe('colorOf("sibling")', 'green');
+shouldBe('colorOf("notNext")', 'black');
+shouldBe('colorOf("later")', 'green');
+element("previous").removeAttribute("class");
+shouldBe('colorOf("sibling")', 'black');
+shouldBe('colorOf("later")', 'black');
+
+debug('');
+debug('Class change on the element itself');
+shouldBe('colorOf("self")', 'black');
+element("self").className = "self on";
+shouldBe('colorOf("self")', 'green');
+element("self").className = "on self";
+shouldBe('colorOf("self")', 'green');
+element("self").className = "on";
+shouldBe('colorOf("self")', 'black');
+
+debug('');
+debug('Id changes');
+shouldBe('colorOf("idTarget")', 'black');
+element("idAncestor").id = "active";
+shouldBe('colorOf("idTarget")', 'green');
+element("active").id = "idAncestor";
+shouldBe('colorOf("idTarget")', 'black');
+shouldBe('colorOf("idSelf")', 'black');
+element("idSelf").id = "activeSelf";
+shouldBe('colorOf("activeSelf")', 'green');
+element("activeSelf").id = "idSelf";
+shouldBe('colorOf("idSelf")', 'black');
+
+debug('');
+debug('Attribute change on an ancestor');
+shouldBe('colorOf("attributeTarget")', 'black');
+element("attributeAncestor").setAttribute("data-state", "on");
+shouldBe('colorOf("attributeTarget")', 'green');
+element("attributeAncestor").setAttribute("data-state", "off");
+shouldBe('colorOf("attributeTarget")', 'black');
+
+document.body.removeChild(container);
+
+var successfullyParsed = true;
@@ -0,0 +1,76 @@
+description(
+"Tests that dates in the layouts Date produces itself parse to the same values as other layouts, and that local time conversions agree with each other when alternating between distant dates."
+);
+
+debug('toUTCString layout');
+shouldBe('Date.parse("Thu, 01 Jan 1970 00:00:00 GMT")', '0');
+shouldBe('Date.parse("Mon, 15 Mar 2010 12:34:56 GMT")', '1268656496000');
+shouldBe('Date.parse("Mon, 15 Mar 2010 12:34:56 GMT")', 'Date.UTC(2010, 2, 15, 12, 34, 56)');
+shouldBe('Date.parse("Fri, 15 Mar 2010 12:34:56 GMT")', 'Date.parse("Mon, 15 Mar 2010 12:34:56 GMT")');
+shouldBe('Date.parse("15 Mar 2010 12:34:56 GMT")', 'Date.parse("Mon, 15 Mar 2010 12:34:56 GMT")');
+shouldBe('Date.parse("Mon, 15 Mar 2010 12:34 GMT")', 'Date.parse("Mon, 15 Mar 2010 12:34:00 GMT")');
+shouldBe('Date.parse("Wed, 31 Dec 1969 23:59:59 GMT")', '-1000');
+
+debug('');
+debug('toString layout');
+shouldBe('Date.parse("Mon Mar 15 2010 12:34:56 GMT+0000 (UTC)")', '1268656496000');
+shouldBe('Date.parse("Mon Mar 15 2010 12:34:56 GMT+0100 (CET)")', '1268652896000');
+shouldBe('Date.parse("Mon Mar 15 2010 12:34:56 GMT-0830")', '1268687096000');
+shouldBe('Date.parse("Mon Mar 15 2010 12:34:56 GMT+0100")', 'Date.parse("Mon, 15 Mar 2010 11:34:56 GMT")');
+
+debug('');
+debug('Round trips');
+var times = [0, -1000, 1268656496000, 951825600000, 1719835200000, 330177600000, 4102444800000, -315576000000];
+
+function timesNotRoundTripping(format)
+{
+    var failures = [];
+    for (var i = 0; i < times.length; ++i) {
+        if (Date.parse(format(times[i])) !== times[i])
+            failures.push(times[i]);
+    }
+    return failures;
+}
+
+shouldBe('timesNotRoundTripping(function(t) { return new Date(t).toUTCString(); })', '[]');
+shouldBe('timesNotRoundTripping(function(t) { return new Date(t).toString(); })', '[]');
+shouldBe('timesNotRoundTripping(function(t) { return new Date(t).toISOString(); })', '[]');
+
+debug('');
+debug('toISOString');
+shouldBe('new Date(0).toISOString()', '"1970-01-01T00:00:00.000Z"');
+shouldBe('new Date(Date.UTC(2010, 2, 15, 12, 34, 56, 7)).toISOString()', '"2010-03-15T12:34:56.007Z"');
+shouldBe('new Date(Date.UTC(9999, 11, 31, 23, 59, 59, 999)).toISOString()', '"9999-12-31T23:59:59.999Z"');
+shouldBe('new Date(Date.UTC(2000, 0, 1)).toISOString()', '"2000-01-01T00:00:00.000Z"');
+shouldBe('new Date(new Date(Date.UTC(2000, 0, 1)).setUTCFullYear(5)).toISOString()', '"0005-01-01T00:00:00.000Z"');
+
+debug('');
+debug('Local time offsets for alternating distant dates');
+
+// Noon UTC stays clear of daylight saving transitions in practically every time zone.
+var noons = [];
+for (var year = 1975; year <= 2035; year += 6) {
+    for (var month = 0; month < 12; month += 5)
+        noons.push(Date.UTC(year, month, 15, 12));
+}
+
+function inconsistentLocalTimes()
+{
+    var failures = [];
+    for (var pass = 0; pass < 2; ++pass) {
+        for (var i = 0; i < noons.length; ++i) {
+            // Alternate between the start and the end of the list.
+            var t = noons[i % 2 ? noons.length - 1 - (i >> 1) : i >> 1];
+            var d = new Date(t);
+            var localAsUTC = Date.UTC(d.getFullYear(), d.getMonth(), d.getDate(), d.getHours(), d.getMinutes(), d.getSeconds(), d.getMilliseconds());
+            var local = new Date(d.getFullYear(), d.getMonth(), d.getDate(), d.getHours(), d.getMinutes(), d.getSeconds(), d.getMilliseconds());
+            if (localAsUTC - t !== -d.getTimezoneOffset() * 60000 || local.getTime() !== t)
+                failures.push(t);
+        }
+    }
+    return failures;
+}
+
+shouldBe('inconsistentLocalTimes()', '[]');
+
+var successfullyParsed = true;
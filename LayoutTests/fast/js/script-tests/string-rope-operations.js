@@ -0,0 +1,80 @@
+description(
+"Tests that charAt, charCodeAt, indexOf, equality and substring give the same results on strings built by concatenation as on flat strings."
+);
+
+function makeRope(parts)
+{
+    var result = "";
+    for (var i = 0; i < parts.length; ++i)
+        result += parts[i];
+    return result;
+}
+
+var flat = "abcdefghijklmno";
+var rope = makeRope(["abc", "def", "ghi", "jkl", "mno"]);
+
+shouldBe('rope.length', '15');
+
+debug('');
+debug('charAt and charCodeAt');
+shouldBe('rope.charAt(0)', '"a"');
+shouldBe('rope.charAt(3)', '"d"');
+shouldBe('rope.charAt(14)', '"o"');
+shouldBe('rope.charAt(15)', '""');
+shouldBe('rope.charAt(-1)', '""');
+shouldBe('rope.charCodeAt(8)', '105');
+shouldBe('rope.charCodeAt(15)', 'NaN');
+
+debug('');
+debug('indexOf');
+shouldBe('rope.indexOf("cde")', '2');
+shouldBe('rope.indexOf("ghijklm")', '6');
+shouldBe('rope.indexOf("abcdefghijklmno")', '0');
+shouldBe('rope.indexOf("o")', '14');
+shouldBe('rope.indexOf("mnop")', '-1');
+shouldBe('rope.indexOf("abcdefghijklmnop")', '-1');
+shouldBe('rope.indexOf("")', '0');
+shouldBe('rope.indexOf("", 20)', '15');
+shouldBe('rope.indexOf("def", 3)', '3');
+shouldBe('rope.indexOf("def", 4)', '-1');
+shouldBe('rope.indexOf("efg", -5)', '4');
+shouldBe('rope.indexOf(makeRope(["fg", "hi"]))', '5');
+
+var partialMatches = makeRope(["aab", "aaa", "bab"]);
+shouldBe('partialMatches.indexOf("aab", 1)', '4');
+shouldBe('partialMatches.indexOf("abab")', '5');
+
+var nested = makeRope([makeRope(["ab", "cd"]), makeRope(["ef", makeRope(["gh", "ij"])])]);
+shouldBe('nested.indexOf("defghi")', '3');
+
+var wide = makeRope(["\u0100x", "y\u0101"]);
+shouldBe('wide.indexOf("xy")', '1');
+shouldBe('wide.indexOf("y\\u0101")', '2');
+
+debug('');
+debug('Equality');
+shouldBeTrue('rope == flat');
+shouldBeTrue('rope === flat');
+shouldBeTrue('flat === rope');
+shouldBeTrue('rope === makeRope(["ab", "cdefg", "hijklmno"])');
+shouldBeFalse('rope === makeRope(["abc", "def", "ghi", "jkl", "mnp"])');
+shouldBeFalse('rope === makeRope(["xbc", "def", "ghi", "jkl", "mno"])');
+shouldBeFalse('rope === makeRope(["abc", "def"])');
+shouldBeTrue('rope != makeRope(["abc", "def"])');
+shouldBeTrue('wide === "\\u0100xy\\u0101"');
+
+debug('');
+debug('Substrings spanning several fibers');
+var many = makeRope(["ab", "cd", "ef", "gh", "ij", "kl"]);
+shouldBe('many.substring(1, 11)', '"bcdefghijk"');
+shouldBe('many.substring(1, 11).length', '10');
+shouldBe('many.substring(1, 11).indexOf("ghij")', '5');
+shouldBe('many.slice(3, 9)', '"defghi"');
+shouldBe('many.substr(2, 8)', '"cdefghij"');
+
+debug('');
+debug('The original strings are unchanged');
+shouldBe('rope', '"abcdefghijklmno"');
+shouldBe('many', '"abcdefghijkl"');
+
+var successfullyParsed = true;
@@ -0,0 +1,75 @@
+description(
+"Tests that line breaks land in the same places when many paragraphs are laid out together. The block holds enough text for its break opportunities to be found on several threads when that is enabled."
+);
+
+var container = document.createElement("div");
+container.setAttribute("style", "width: 0; font: 10px/10px monospace;");
+document.body.appendChild(container);
+
+// Every word ends up on its own line, so a paragraph is ten pixels tall per word.
+var paragraphCount = 80;
+var longWord = "";
+for (var i = 0; i < 60; ++i)
+    longWord += String.fromCharCode(97 + i % 26);
+
+function wordCount(i)
+{
+    return i % 7 + 1;
+}
+
+var paragraphs = [];
+for (var i = 0; i < paragraphCount; ++i) {
+    var words = [];
+    for (var j = 0; j < wordCount(i); ++j)
+        words.push(longWord);
+    var p = document.createElement("p");
+    p.setAttribute("style", "margin: 0");
+    p.appendChild(document.createTextNode(words.join(" ")));
+    container.appendChild(p);
+    paragraphs.push(p);
+}
+
+function addParagraph(id, text)
+{
+    var p = document.createElement("p");
+    p.id = id;
+    p.setAttribute("style", "margin: 0");
+    p.appendChild(document.createTextNode(text));
+    container.appendChild(p);
+}
+
+addParagraph("ideographs", "\u4e00\u4e8c\u4e09\u56db");
+addParagraph("hyphen", "ab-cd");
+addParagraph("noBreakSpace", "ab\u00a0cd");
+addParagraph("accented", "\u00e9t\u00e9 \u00e0 caf\u00e9");
+
+function paragraphsWithWrongHeight()
+{
+    var wrong = [];
+    for (var i = 0; i < paragraphCount; ++i) {
+        if (paragraphs[i].offsetHeight != wordCount(i) * 10)
+            wrong.push(i);
+    }
+    return wrong;
+}
+
+function heightOf(id)
+{
+    return document.getElementById(id).offsetHeight;
+}
+
+shouldBe('paragraphsWithWrongHeight()', '[]');
+shouldBe('heightOf("ideographs")', '40');
+shouldBe('heightOf("hyphen")', '20');
+shouldBe('heightOf("noBreakSpace")', '10');
+shouldBe('heightOf("accented")', '30');
+
+debug('');
+debug('After changing the text of one paragraph');
+paragraphs[3].firstChild.data = "a b c d e f g h i j";
+shouldBe('paragraphs[3].offsetHeight', '100');
+shouldBe('paragraphs[4].offsetHeight', '50');
+
+document.body.removeChild(container);
+
+var successfullyParsed = true;
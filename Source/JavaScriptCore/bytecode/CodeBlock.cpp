@@ -396,6 +396,10 @@ void CodeBlock::dump(ExecState* exec) const
             printStructureStubInfo(m_structureStubInfos[i], instructionOffsetForNth(exec, m_instructions, i + 1, isPropertyAccess));
              ++i;
         } while (i < m_structureStubInfos.size());
+
+        PropertyAccessSiteCounts counts;
+        countPropertyAccessSites(counts);
+        printf("  %u unlinked, %u monomorphic, %u polymorphic, %u megamorphic\n", counts.unlinked, counts.monomorphic, counts.polymorphic, counts.megamorphic);
     }
 #else
     if (!m_globalResolveInstructions.isEmpty() || !m_propertyAccessInstructions.isEmpty())
@@ -1239,6 +1243,53 @@ void CodeBlock::dump(ExecState* exec, const Vector<Instruction>::const_iterator&
 static HashSet<CodeBlock*> liveCodeBlockSet;
 #endif
 
+#if ENABLE(JIT)
+void CodeBlock::countPropertyAccessSites(PropertyAccessSiteCounts& counts) const
+{
+    counts.unlinked = 0;
+    counts.monomorphic = 0;
+    counts.polymorphic = 0;
+    counts.megamorphic = 0;
+
+    for (size_t i = 0; i < m_structureStubInfos.size(); ++i) {
+        const StructureStubInfo& stubInfo = m_structureStubInfos[i];
+        if (stubInfo.repatchedToGeneric) {
+            ++counts.megamorphic;
+            continue;
+        }
+        switch (stubInfo.accessType) {
+        case access_get_by_id:
+        case access_put_by_id:
+            ++counts.unlinked;
+            break;
+        case access_get_by_id_self:
+        case access_get_by_id_proto:
+        case access_get_by_id_chain:
+        case access_put_by_id_transition:
+        case access_put_by_id_replace:
+        case access_get_array_length:
+        case access_get_string_length:
+            ++counts.monomorphic;
+            break;
+        case access_get_by_id_self_list:
+        case access_get_by_id_proto_list:
+            // Both list kinds share a layout. A full list means the site was repatched to a generic stub.
+            if (stubInfo.u.getByIdProtoList.listSize < POLYMORPHIC_LIST_CACHE_SIZE)
+                ++counts.polymorphic;
+            else
+                ++counts.megamorphic;
+            break;
+        case access_get_by_id_generic:
+        case access_put_by_id_generic:
+            ++counts.megamorphic;
+            break;
+        default:
+            ASSERT_NOT_REACHED();
+        }
+    }
+}
+#endif
+
 #define FOR_EACH_MEMBER_VECTOR(macro) \
     macro(instructions) \
     macro(globalResolveInfos) \
@@ -260,6 +260,16 @@ namespace JSC {
             return *(binarySearch<MethodCallLinkInfo, void*, getMethodCallLinkInfoReturnLocation>(m_methodCallLinkInfos.begin(), m_methodCallLinkInfos.size(), returnAddress.value()));
         }
 
+        // Classifies the property access sites of this block by how many structures they have
+        // seen; sites that gave up on caching and use the generic stubs count as megamorphic.
+        struct PropertyAccessSiteCounts {
+            unsigned unlinked;
+            unsigned monomorphic;
+            unsigned polymorphic;
+            unsigned megamorphic;
+        };
+        void countPropertyAccessSites(PropertyAccessSiteCounts&) const;
+
         unsigned bytecodeOffset(ReturnAddressPtr returnAddress)
         {
             if (!m_rareData)
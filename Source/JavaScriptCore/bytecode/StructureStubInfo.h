@@ -55,6 +55,7 @@ namespace JSC {
         StructureStubInfo(AccessType accessType)
             : accessType(accessType)
             , seen(false)
+            , repatchedToGeneric(false)
         {
         }
 
@@ -128,8 +129,17 @@ namespace JSC {
             seen = true;
         }
 
-        int accessType : 31;
+        // Set when the slow path call is repatched to the generic stub while
+        // the inline cache still uses the cached structures, so accessType
+        // has to keep describing them.
+        void setRepatchedToGeneric()
+        {
+            repatchedToGeneric = true;
+        }
+
+        int accessType : 30;
         int seen : 1;
+        int repatchedToGeneric : 1;
 
         union {
             struct {
@@ -77,6 +77,8 @@ void Heap::destroy()
 
 #if ENABLE(JIT)
     m_globalData->jitStubs->clearHostFunctionStubs();
+    // The cached identifiers must go before the identifier table does.
+    m_globalData->jitStubs->megamorphicCache().clear();
 #endif
 
     delete m_markListSet;
@@ -394,6 +396,10 @@ void Heap::reset(SweepToggle sweepToggle)
     markRoots();
     m_handleHeap.finalizeWeakHandles();
 
+#if ENABLE(JIT)
+    m_globalData->jitStubs->megamorphicCache().clear();
+#endif
+
     JAVASCRIPTCORE_GC_MARKED();
 
     m_markedSpace.reset();
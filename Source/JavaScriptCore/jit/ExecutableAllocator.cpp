@@ -77,6 +77,13 @@ size_t ExecutableAllocator::committedByteCount()
     return 0;
 } 
 
+ExecutableAllocator::Statistics ExecutableAllocator::statistics()
+{
+    Statistics statistics;
+    memset(&statistics, 0, sizeof(statistics));
+    return statistics;
+}
+
 #endif
 
 #if ENABLE(ASSEMBLER_WX_EXCLUSIVE)
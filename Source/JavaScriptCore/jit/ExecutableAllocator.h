@@ -331,6 +331,16 @@ public:
 #endif
     static size_t committedByteCount();
 
+    // Fragmentation of the executable memory region; the demand allocator reports all zeroes.
+    struct Statistics {
+        size_t reservedBytes;
+        size_t committedBytes;
+        size_t allocationCount;
+        size_t freeBlockCount;
+        size_t largestFreeBlockBytes;
+    };
+    static Statistics statistics();
+
 private:
 
 #if ENABLE(ASSEMBLER_WX_EXCLUSIVE)
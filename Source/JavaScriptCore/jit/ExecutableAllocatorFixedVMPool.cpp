@@ -146,6 +146,11 @@ public:
         return !~m_allocated;
     }
 
+    bool isAllocated(size_t location)
+    {
+        return m_allocated & (1ull << (location >> log2SubregionSize));
+    }
+
     static size_t size()
     {
         return regionSize;
@@ -213,6 +218,11 @@ public:
         return m_ptr && m_ptr->isFull();
     }
 
+    bool isAllocated(size_t location)
+    {
+        return m_ptr && m_ptr->isAllocated(location);
+    }
+
     static size_t size()
     {
         return NextLevel::size();
@@ -334,6 +344,15 @@ public:
         return !~m_full;
     }
 
+    bool isAllocated(size_t location)
+    {
+        size_t entry = location >> log2SubregionSize;
+        BitField bit = 1ull << entry;
+        if (m_hasSuballocation & bit)
+            return m_suballocations[entry].isAllocated(location & (subregionSize - 1));
+        return m_full & bit;
+    }
+
     static size_t size()
     {
         return regionSize;
@@ -403,6 +422,7 @@ class FixedVMPoolAllocator
 {
 public:
     FixedVMPoolAllocator()
+        : m_allocationCount(0)
     {
         ASSERT(PageTables256KB::size() == 256 * 1024);
         ASSERT(PageTables16MB::size() == 16 * 1024 * 1024);
@@ -434,6 +454,7 @@ public:
 
         void* pointer = offsetToPointer(offset);
         m_reservation.commit(pointer, size);
+        ++m_allocationCount;
         return ExecutablePool::Allocation(pointer, size);
     }
 
@@ -448,6 +469,8 @@ public:
         AllocationTableSizeClass sizeClass = classForSize(size);
         ASSERT(sizeClass.size() == size);
         m_pages.free(pointerToOffset(pointer), sizeClass);
+        ASSERT(m_allocationCount);
+        --m_allocationCount;
     }
 
     size_t allocated()
@@ -455,6 +478,29 @@ public:
         return m_reservation.committed();
     }
 
+    // Walks the page tables to find the runs of free pages left between live allocations.
+    void getStatistics(ExecutableAllocator::Statistics& statistics)
+    {
+        const size_t subregionSize = PageTables256KB::subregionSize;
+
+        statistics.reservedBytes = FixedVMPoolPageTables::size();
+        statistics.committedBytes = m_reservation.committed();
+        statistics.allocationCount = m_allocationCount;
+        statistics.freeBlockCount = 0;
+        statistics.largestFreeBlockBytes = 0;
+
+        size_t freeRun = 0;
+        for (size_t offset = 0; offset < FixedVMPoolPageTables::size(); offset += subregionSize) {
+            if (!m_pages.isAllocated(offset)) {
+                if (!freeRun)
+                    ++statistics.freeBlockCount;
+                freeRun += subregionSize;
+                statistics.largestFreeBlockBytes = std::max(statistics.largestFreeBlockBytes, freeRun);
+            } else
+                freeRun = 0;
+        }
+    }
+
     bool isValid() const
     {
         return !!m_reservation;
@@ -478,6 +524,7 @@ private:
 
     PageReservation m_reservation;
     FixedVMPoolPageTables m_pages;
+    size_t m_allocationCount;
 };
 
 
@@ -504,6 +551,17 @@ bool ExecutableAllocator::isValid() const
     return allocator->isValid();
 }
 
+ExecutableAllocator::Statistics ExecutableAllocator::statistics()
+{
+    Statistics statistics;
+    SpinLockHolder lockHolder(&spinlock);
+    if (allocator)
+        allocator->getStatistics(statistics);
+    else
+        memset(&statistics, 0, sizeof(statistics));
+    return statistics;
+}
+
 bool ExecutableAllocator::underMemoryPressure()
 {
     // Technically we should take the spin lock here, but we don't care if we get stale data.
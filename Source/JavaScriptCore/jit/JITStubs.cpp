@@ -801,6 +801,77 @@ JITThunks::~JITThunks()
 {
 }
 
+MegamorphicCache::MegamorphicCache()
+{
+    clear();
+}
+
+MegamorphicCache::~MegamorphicCache()
+{
+}
+
+inline unsigned MegamorphicCache::entryIndex(Structure* structure, StringImpl* propertyName)
+{
+    return (PtrHash<Structure*>::hash(structure) + propertyName->existingHash()) & (cacheSize - 1);
+}
+
+bool MegamorphicCache::get(JSValue baseValue, const Identifier& propertyName, JSValue& result)
+{
+    if (!baseValue.isObject())
+        return false;
+
+    JSObject* object = asObject(baseValue);
+    Structure* structure = object->structure();
+    Entry& entry = m_entries[entryIndex(structure, propertyName.impl())];
+    if (entry.structure != structure || entry.propertyName != propertyName.impl())
+        return false;
+
+    if (entry.prototypeStructure) {
+        // A structure always has the same prototype, so only its shape needs checking.
+        JSObject* prototype = asObject(structure->storedPrototype());
+        if (prototype->structure() != entry.prototypeStructure)
+            return false;
+        object = prototype;
+    }
+
+    result = object->getDirectOffset(entry.offset);
+    return true;
+}
+
+void MegamorphicCache::add(JSValue baseValue, const Identifier& propertyName, const PropertySlot& slot)
+{
+    if (!baseValue.isObject() || !slot.isCacheable() || slot.cachedPropertyType() != PropertySlot::Value)
+        return;
+
+    Structure* structure = asObject(baseValue)->structure();
+    if (structure->isDictionary())
+        return;
+
+    Structure* prototypeStructure = 0;
+    if (slot.slotBase() != baseValue) {
+        JSValue prototype = structure->storedPrototype();
+        if (slot.slotBase() != prototype)
+            return;
+        prototypeStructure = asObject(prototype)->structure();
+        if (prototypeStructure->isDictionary())
+            return;
+    }
+
+    Entry& entry = m_entries[entryIndex(structure, propertyName.impl())];
+    entry.structure = structure;
+    entry.propertyName = propertyName.impl();
+    entry.prototypeStructure = prototypeStructure;
+    entry.offset = slot.cachedOffset();
+}
+
+void MegamorphicCache::clear()
+{
+    for (unsigned i = 0; i < cacheSize; ++i) {
+        m_entries[i].structure = 0;
+        m_entries[i].propertyName = 0;
+    }
+}
+
 #if ENABLE(JIT_OPTIMIZE_PROPERTY_ACCESS)
 
 NEVER_INLINE void JITThunks::tryCachePutByID(CallFrame* callFrame, CodeBlock* codeBlock, ReturnAddressPtr returnAddress, JSValue baseValue, const PutPropertySlot& slot, StructureStubInfo* stubInfo, bool direct)
@@ -860,6 +931,7 @@ NEVER_INLINE void JITThunks::tryCacheGetByID(CallFrame* callFrame, CodeBlock* co
 
     // FIXME: Cache property access for immediates.
     if (!baseValue.isCell()) {
+        stubInfo->accessType = access_get_by_id_generic;
         ctiPatchCallByReturnAddress(codeBlock, returnAddress, FunctionPtr(cti_op_get_by_id_generic));
         return;
     }
@@ -880,6 +952,7 @@ NEVER_INLINE void JITThunks::tryCacheGetByID(CallFrame* callFrame, CodeBlock* co
 
     // Uncacheable: give up.
     if (!slot.isCacheable()) {
+        stubInfo->accessType = access_get_by_id_generic;
         ctiPatchCallByReturnAddress(codeBlock, returnAddress, FunctionPtr(cti_op_get_by_id_generic));
         return;
     }
@@ -888,6 +961,7 @@ NEVER_INLINE void JITThunks::tryCacheGetByID(CallFrame* callFrame, CodeBlock* co
     Structure* structure = baseCell->structure();
 
     if (structure->isUncacheableDictionary()) {
+        stubInfo->accessType = access_get_by_id_generic;
         ctiPatchCallByReturnAddress(codeBlock, returnAddress, FunctionPtr(cti_op_get_by_id_generic));
         return;
     }
@@ -905,6 +979,7 @@ NEVER_INLINE void JITThunks::tryCacheGetByID(CallFrame* callFrame, CodeBlock* co
     }
 
     if (structure->isDictionary()) {
+        stubInfo->accessType = access_get_by_id_generic;
         ctiPatchCallByReturnAddress(codeBlock, returnAddress, FunctionPtr(cti_op_get_by_id_generic));
         return;
     }
@@ -1420,10 +1495,16 @@ DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_id_generic)
     Identifier& ident = stackFrame.args[1].identifier();
 
     JSValue baseValue = stackFrame.args[0].jsValue();
+    MegamorphicCache& megamorphicCache = stackFrame.globalData->jitStubs->megamorphicCache();
+    JSValue result;
+    if (megamorphicCache.get(baseValue, ident, result))
+        return JSValue::encode(result);
+
     PropertySlot slot(baseValue);
-    JSValue result = baseValue.get(callFrame, ident, slot);
+    result = baseValue.get(callFrame, ident, slot);
+    CHECK_FOR_EXCEPTION();
 
-    CHECK_FOR_EXCEPTION_AT_END();
+    megamorphicCache.add(baseValue, ident, slot);
     return JSValue::encode(result);
 }
 
@@ -1640,11 +1721,17 @@ DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_id_self_fail)
             stubInfo->u.getByIdSelfList.listSize++;
             JIT::compileGetByIdSelfList(callFrame->scopeChain()->globalData, codeBlock, stubInfo, polymorphicStructureList, listIndex, baseValue.asCell()->structure(), ident, slot, slot.cachedOffset());
 
-            if (listIndex == (POLYMORPHIC_LIST_CACHE_SIZE - 1))
+            if (listIndex == (POLYMORPHIC_LIST_CACHE_SIZE - 1)) {
+                stubInfo->setRepatchedToGeneric();
                 ctiPatchCallByReturnAddress(codeBlock, STUB_RETURN_ADDRESS, FunctionPtr(cti_op_get_by_id_generic));
+            }
         }
-    } else
+    } else {
+        // The site is a self access or self list here, which the inline cache
+        // still uses, so accessType stays as it is.
+        callFrame->codeBlock()->getStubInfo(STUB_RETURN_ADDRESS).setRepatchedToGeneric();
         ctiPatchCallByReturnAddress(callFrame->codeBlock(), STUB_RETURN_ADDRESS, FunctionPtr(cti_op_get_by_id_generic));
+    }
     return JSValue::encode(result);
 }
 
@@ -1777,11 +1864,18 @@ DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_id_proto_list_full)
 {
     STUB_INIT_STACK_FRAME(stackFrame);
 
+    Identifier& ident = stackFrame.args[1].identifier();
     JSValue baseValue = stackFrame.args[0].jsValue();
+    MegamorphicCache& megamorphicCache = stackFrame.globalData->jitStubs->megamorphicCache();
+    JSValue result;
+    if (megamorphicCache.get(baseValue, ident, result))
+        return JSValue::encode(result);
+
     PropertySlot slot(baseValue);
-    JSValue result = baseValue.get(stackFrame.callFrame, stackFrame.args[1].identifier(), slot);
+    result = baseValue.get(stackFrame.callFrame, ident, slot);
+    CHECK_FOR_EXCEPTION();
 
-    CHECK_FOR_EXCEPTION_AT_END();
+    megamorphicCache.add(baseValue, ident, slot);
     return JSValue::encode(result);
 }
 
@@ -2335,6 +2429,106 @@ DEFINE_STUB_FUNCTION(EncodedJSValue, op_construct_NotJSConstruct)
     VM_THROW_EXCEPTION();
 }
 
+// Returns TypedArrayTypeCount if the value is not a registered typed array wrapper.
+static inline TypedArrayType typedArrayTypeOf(JSGlobalData* globalData, JSValue value)
+{
+    if (!value.isCell())
+        return TypedArrayTypeCount;
+    const ClassInfo* classInfo = value.asCell()->classInfo();
+    for (unsigned type = 0; type < TypedArrayTypeCount; ++type) {
+        if (globalData->typedArrayDescriptor(static_cast<TypedArrayType>(type)).m_classInfo == classInfo)
+            return static_cast<TypedArrayType>(type);
+    }
+    return TypedArrayTypeCount;
+}
+
+// These mirror the conversions done by the typed array bindings' index getters and setters.
+static inline bool getTypedArrayIndex(JSGlobalData* globalData, TypedArrayType type, JSCell* cell, unsigned i, JSValue& result)
+{
+    unsigned length;
+    void* storage = globalData->typedArrayDescriptor(type).m_storage(cell, length);
+    if (i >= length)
+        return false;
+
+    switch (type) {
+    case TypedArrayInt8:
+        result = jsNumber(static_cast<int>(static_cast<int8_t*>(storage)[i]));
+        return true;
+    case TypedArrayUint8:
+    case TypedArrayUint8Clamped:
+        result = jsNumber(static_cast<int>(static_cast<uint8_t*>(storage)[i]));
+        return true;
+    case TypedArrayInt16:
+        result = jsNumber(static_cast<int>(static_cast<int16_t*>(storage)[i]));
+        return true;
+    case TypedArrayUint16:
+        result = jsNumber(static_cast<int>(static_cast<uint16_t*>(storage)[i]));
+        return true;
+    case TypedArrayInt32:
+        result = jsNumber(static_cast<int32_t*>(storage)[i]);
+        return true;
+    case TypedArrayUint32:
+        result = jsNumber(static_cast<uint32_t*>(storage)[i]);
+        return true;
+    case TypedArrayFloat32: {
+        // Arbitrary bit patterns may be stored in the array, so make sure any NaN we box is the canonical one.
+        double value = static_cast<float*>(storage)[i];
+        result = jsNumber(isnan(value) ? NaN : value);
+        return true;
+    }
+    case TypedArrayTypeCount:
+        break;
+    }
+    ASSERT_NOT_REACHED();
+    return false;
+}
+
+static inline bool putTypedArrayIndex(JSGlobalData* globalData, TypedArrayType type, JSCell* cell, unsigned i, JSValue value)
+{
+    // Converting anything but a number may call out to script, so leave that to the bindings.
+    double number;
+    if (value.isInt32())
+        number = value.asInt32();
+    else if (!value.getNumber(number))
+        return false;
+
+    unsigned length;
+    void* storage = globalData->typedArrayDescriptor(type).m_storage(cell, length);
+    if (i >= length)
+        return false;
+
+    switch (type) {
+    case TypedArrayInt8:
+        static_cast<int8_t*>(storage)[i] = doubleToTypedArrayInteger<int8_t>(number);
+        return true;
+    case TypedArrayUint8:
+        static_cast<uint8_t*>(storage)[i] = doubleToTypedArrayInteger<uint8_t>(number);
+        return true;
+    case TypedArrayUint8Clamped:
+        static_cast<uint8_t*>(storage)[i] = doubleToClampedByte(number);
+        return true;
+    case TypedArrayInt16:
+        static_cast<int16_t*>(storage)[i] = doubleToTypedArrayInteger<int16_t>(number);
+        return true;
+    case TypedArrayUint16:
+        static_cast<uint16_t*>(storage)[i] = doubleToTypedArrayInteger<uint16_t>(number);
+        return true;
+    case TypedArrayInt32:
+        static_cast<int32_t*>(storage)[i] = doubleToTypedArrayInteger<int32_t>(number);
+        return true;
+    case TypedArrayUint32:
+        static_cast<uint32_t*>(storage)[i] = doubleToTypedArrayInteger<uint32_t>(number);
+        return true;
+    case TypedArrayFloat32:
+        static_cast<float*>(storage)[i] = static_cast<float>(number);
+        return true;
+    case TypedArrayTypeCount:
+        break;
+    }
+    ASSERT_NOT_REACHED();
+    return false;
+}
+
 DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_val)
 {
     STUB_INIT_STACK_FRAME(stackFrame);
@@ -2370,6 +2564,15 @@ DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_val)
             ctiPatchCallByReturnAddress(callFrame->codeBlock(), STUB_RETURN_ADDRESS, FunctionPtr(cti_op_get_by_val_byte_array));
             return JSValue::encode(asByteArray(baseValue)->getIndex(callFrame, i));
         }
+        TypedArrayType typedArrayType = typedArrayTypeOf(globalData, baseValue);
+        if (typedArrayType != TypedArrayTypeCount) {
+            JSValue result;
+            if (getTypedArrayIndex(globalData, typedArrayType, baseValue.asCell(), i, result)) {
+                // Like byte arrays, in-bounds typed array reads cannot throw.
+                ctiPatchCallByReturnAddress(callFrame->codeBlock(), STUB_RETURN_ADDRESS, FunctionPtr(cti_op_get_by_val_typed_array));
+                return JSValue::encode(result);
+            }
+        }
         JSValue result = baseValue.get(callFrame, i);
         CHECK_FOR_EXCEPTION();
         return JSValue::encode(result);
@@ -2442,6 +2645,36 @@ DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_val_byte_array)
     return JSValue::encode(result);
 }
 
+DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_val_typed_array)
+{
+    STUB_INIT_STACK_FRAME(stackFrame);
+    
+    CallFrame* callFrame = stackFrame.callFrame;
+    JSGlobalData* globalData = stackFrame.globalData;
+    
+    JSValue baseValue = stackFrame.args[0].jsValue();
+    JSValue subscript = stackFrame.args[1].jsValue();
+    
+    JSValue result;
+
+    if (LIKELY(subscript.isUInt32())) {
+        uint32_t i = subscript.asUInt32();
+        TypedArrayType typedArrayType = typedArrayTypeOf(globalData, baseValue);
+        if (typedArrayType != TypedArrayTypeCount && getTypedArrayIndex(globalData, typedArrayType, baseValue.asCell(), i, result))
+            return JSValue::encode(result);
+
+        result = baseValue.get(callFrame, i);
+        if (typedArrayType == TypedArrayTypeCount)
+            ctiPatchCallByReturnAddress(callFrame->codeBlock(), STUB_RETURN_ADDRESS, FunctionPtr(cti_op_get_by_val));
+    } else {
+        Identifier property(callFrame, subscript.toString(callFrame));
+        result = baseValue.get(callFrame, property);
+    }
+    
+    CHECK_FOR_EXCEPTION_AT_END();
+    return JSValue::encode(result);
+}
+
 DEFINE_STUB_FUNCTION(EncodedJSValue, op_sub)
 {
     STUB_INIT_STACK_FRAME(stackFrame);
@@ -2495,8 +2728,16 @@ DEFINE_STUB_FUNCTION(void, op_put_by_val)
             }
 
             baseValue.put(callFrame, i, value);
-        } else
+        } else {
+            TypedArrayType typedArrayType = typedArrayTypeOf(globalData, baseValue);
+            if (typedArrayType != TypedArrayTypeCount) {
+                ctiPatchCallByReturnAddress(callFrame->codeBlock(), STUB_RETURN_ADDRESS, FunctionPtr(cti_op_put_by_val_typed_array));
+                // In-bounds stores of numbers cannot throw, so return immediately to avoid exception checks.
+                if (putTypedArrayIndex(globalData, typedArrayType, baseValue.asCell(), i, value))
+                    return;
+            }
             baseValue.put(callFrame, i, value);
+        }
     } else {
         Identifier property(callFrame, subscript.toString(callFrame));
         if (!stackFrame.globalData->exception) { // Don't put to an object if toString threw an exception.
@@ -2551,6 +2792,37 @@ DEFINE_STUB_FUNCTION(void, op_put_by_val_byte_array)
     CHECK_FOR_EXCEPTION_AT_END();
 }
 
+DEFINE_STUB_FUNCTION(void, op_put_by_val_typed_array)
+{
+    STUB_INIT_STACK_FRAME(stackFrame);
+    
+    CallFrame* callFrame = stackFrame.callFrame;
+    JSGlobalData* globalData = stackFrame.globalData;
+    
+    JSValue baseValue = stackFrame.args[0].jsValue();
+    JSValue subscript = stackFrame.args[1].jsValue();
+    JSValue value = stackFrame.args[2].jsValue();
+    
+    if (LIKELY(subscript.isUInt32())) {
+        uint32_t i = subscript.asUInt32();
+        TypedArrayType typedArrayType = typedArrayTypeOf(globalData, baseValue);
+        if (typedArrayType != TypedArrayTypeCount && putTypedArrayIndex(globalData, typedArrayType, baseValue.asCell(), i, value))
+            return;
+
+        if (typedArrayType == TypedArrayTypeCount)
+            ctiPatchCallByReturnAddress(callFrame->codeBlock(), STUB_RETURN_ADDRESS, FunctionPtr(cti_op_put_by_val));
+        baseValue.put(callFrame, i, value);
+    } else {
+        Identifier property(callFrame, subscript.toString(callFrame));
+        if (!stackFrame.globalData->exception) { // Don't put to an object if toString threw an exception.
+            PutPropertySlot slot(callFrame->codeBlock()->isStrictMode());
+            baseValue.put(callFrame, property, value, slot);
+        }
+    }
+    
+    CHECK_FOR_EXCEPTION_AT_END();
+}
+
 DEFINE_STUB_FUNCTION(EncodedJSValue, op_lesseq)
 {
     STUB_INIT_STACK_FRAME(stackFrame);
@@ -35,6 +35,7 @@
 #include "Register.h"
 #include "ThunkGenerators.h"
 #include <wtf/HashMap.h>
+#include <wtf/text/StringImpl.h>
 
 #if ENABLE(JIT)
 
@@ -58,6 +59,7 @@ namespace JSC {
     class PutPropertySlot;
     class RegisterFile;
     class RegExp;
+    class Structure;
 
     union JITStubArg {
         void* asPointer;
@@ -277,6 +279,34 @@ namespace JSC {
 
     template <typename T> class Strong;
 
+    // Shared by all get_by_id sites that have given up on their polymorphic stub lists.
+    // Entries are keyed on (Structure, property name) and cover properties found on the
+    // object itself or directly on its prototype. The cache is flushed by every garbage
+    // collection, since the structures it names may be freed afterwards.
+    class MegamorphicCache {
+        WTF_MAKE_NONCOPYABLE(MegamorphicCache);
+    public:
+        MegamorphicCache();
+        ~MegamorphicCache();
+
+        bool get(JSValue baseValue, const Identifier& propertyName, JSValue& result);
+        void add(JSValue baseValue, const Identifier& propertyName, const PropertySlot&);
+        void clear();
+
+    private:
+        struct Entry {
+            Structure* structure;
+            RefPtr<StringImpl> propertyName;
+            Structure* prototypeStructure;
+            size_t offset;
+        };
+
+        static const unsigned cacheSize = 512;
+        static unsigned entryIndex(Structure*, StringImpl*);
+
+        Entry m_entries[cacheSize];
+    };
+
     class JITThunks {
     public:
         JITThunks(JSGlobalData*);
@@ -301,6 +331,8 @@ namespace JSC {
 
         void clearHostFunctionStubs();
 
+        MegamorphicCache& megamorphicCache() { return m_megamorphicCache; }
+
     private:
         typedef HashMap<ThunkGenerator, MacroAssemblerCodePtr> CTIStubMap;
         CTIStubMap m_ctiStubMap;
@@ -309,6 +341,7 @@ namespace JSC {
         RefPtr<ExecutablePool> m_executablePool;
 
         TrampolineStructure m_trampolineStructure;
+        MegamorphicCache m_megamorphicCache;
     };
 
 extern "C" {
@@ -341,6 +374,7 @@ extern "C" {
     EncodedJSValue JIT_STUB cti_op_get_by_id_string_fail(STUB_ARGS_DECLARATION);
     EncodedJSValue JIT_STUB cti_op_get_by_val(STUB_ARGS_DECLARATION);
     EncodedJSValue JIT_STUB cti_op_get_by_val_byte_array(STUB_ARGS_DECLARATION);
+    EncodedJSValue JIT_STUB cti_op_get_by_val_typed_array(STUB_ARGS_DECLARATION);
     EncodedJSValue JIT_STUB cti_op_get_by_val_string(STUB_ARGS_DECLARATION);
     EncodedJSValue JIT_STUB cti_op_in(STUB_ARGS_DECLARATION);
     EncodedJSValue JIT_STUB cti_op_instanceof(STUB_ARGS_DECLARATION);
@@ -414,6 +448,7 @@ extern "C" {
     void JIT_STUB cti_op_put_by_index(STUB_ARGS_DECLARATION);
     void JIT_STUB cti_op_put_by_val(STUB_ARGS_DECLARATION);
     void JIT_STUB cti_op_put_by_val_byte_array(STUB_ARGS_DECLARATION);
+    void JIT_STUB cti_op_put_by_val_typed_array(STUB_ARGS_DECLARATION);
     void JIT_STUB cti_op_put_getter(STUB_ARGS_DECLARATION);
     void JIT_STUB cti_op_put_setter(STUB_ARGS_DECLARATION);
     void JIT_STUB cti_op_tear_off_activation(STUB_ARGS_DECLARATION);
@@ -59,9 +59,10 @@ double parseDate(ExecState* exec, const UString &date)
 {
     if (date == exec->globalData().cachedDateString)
         return exec->globalData().cachedDateStringValue;
-    double value = parseES5DateFromNullTerminatedCharacters(date.utf8().data());
+    CString dateUTF8 = date.utf8();
+    double value = parseES5DateFromNullTerminatedCharacters(dateUTF8.data());
     if (isnan(value))
-        value = parseDateFromNullTerminatedCharacters(exec, date.utf8().data());
+        value = parseDateFromNullTerminatedCharacters(exec, dateUTF8.data());
     exec->globalData().cachedDateString = date;
     exec->globalData().cachedDateStringValue = value;
     return value;
@@ -487,6 +487,16 @@ EncodedJSValue JSC_HOST_CALL dateProtoFuncToUTCString(ExecState* exec)
     return JSValue::encode(jsMakeNontrivialString(exec, date, " ", time));
 }
 
+static inline UChar* appendDigits(UChar* destination, int value, int width)
+{
+    ASSERT(value >= 0);
+    for (int i = width - 1; i >= 0; --i) {
+        destination[i] = '0' + value % 10;
+        value /= 10;
+    }
+    return destination + width;
+}
+
 EncodedJSValue JSC_HOST_CALL dateProtoFuncToISOString(ExecState* exec)
 {
     JSValue thisValue = exec->hostThisValue();
@@ -498,10 +508,34 @@ EncodedJSValue JSC_HOST_CALL dateProtoFuncToISOString(ExecState* exec)
     const GregorianDateTime* gregorianDateTime = thisDateObj->gregorianDateTimeUTC(exec);
     if (!gregorianDateTime)
         return JSValue::encode(jsNontrivialString(exec, "Invalid Date"));
+    int year = 1900 + gregorianDateTime->year;
+    int milliseconds = static_cast<int>(fmod(thisDateObj->internalNumber(), 1000));
+    if (year >= 0 && year <= 9999 && milliseconds >= 0) {
+        // The common case has a fixed layout, so fill it in directly rather than going through snprintf.
+        UChar characters[24];
+        UChar* p = characters;
+        p = appendDigits(p, year, 4);
+        *p++ = '-';
+        p = appendDigits(p, gregorianDateTime->month + 1, 2);
+        *p++ = '-';
+        p = appendDigits(p, gregorianDateTime->monthDay, 2);
+        *p++ = 'T';
+        p = appendDigits(p, gregorianDateTime->hour, 2);
+        *p++ = ':';
+        p = appendDigits(p, gregorianDateTime->minute, 2);
+        *p++ = ':';
+        p = appendDigits(p, gregorianDateTime->second, 2);
+        *p++ = '.';
+        p = appendDigits(p, milliseconds, 3);
+        *p++ = 'Z';
+        ASSERT(p == characters + WTF_ARRAY_LENGTH(characters));
+        return JSValue::encode(jsNontrivialString(exec, UString(characters, WTF_ARRAY_LENGTH(characters))));
+    }
+
     // Maximum amount of space we need in buffer: 6 (max. digits in year) + 2 * 5 (2 characters each for month, day, hour, minute, second) + 4 (. + 3 digits for milliseconds)
     // 6 for formatting and one for null termination = 27.  We add one extra character to allow us to force null termination.
     char buffer[28];
-    snprintf(buffer, sizeof(buffer) - 1, "%04d-%02d-%02dT%02d:%02d:%02d.%03dZ", 1900 + gregorianDateTime->year, gregorianDateTime->month + 1, gregorianDateTime->monthDay, gregorianDateTime->hour, gregorianDateTime->minute, gregorianDateTime->second, static_cast<int>(fmod(thisDateObj->internalNumber(), 1000)));
+    snprintf(buffer, sizeof(buffer) - 1, "%04d-%02d-%02dT%02d:%02d:%02d.%03dZ", year, gregorianDateTime->month + 1, gregorianDateTime->monthDay, gregorianDateTime->hour, gregorianDateTime->minute, gregorianDateTime->second, milliseconds);
     buffer[sizeof(buffer) - 1] = 0;
     return JSValue::encode(jsNontrivialString(exec, buffer));
 }
@@ -58,6 +58,7 @@ namespace JSC {
 
     class CodeBlock;
     class CommonIdentifiers;
+    class JSCell;
     class HandleStack;
     class IdentifierTable;
     class Interpreter;
@@ -74,10 +75,32 @@ namespace JSC {
     class RegExp;
 #endif
 
+    struct ClassInfo;
     struct HashTable;
     struct Instruction;
 
+    // Caches the DST offset over a few disjoint time intervals, so that code
+    // alternating between distant dates (e.g. a calendar rendering several
+    // months, or converting local times back to UTC) does not keep throwing
+    // away the interval it is about to come back to.
     struct DSTOffsetCache {
+        struct Entry {
+            void reset()
+            {
+                offset = 0.0;
+                start = 0.0;
+                end = -1.0;
+                increment = 0.0;
+            }
+
+            double offset;
+            double start;
+            double end;
+            double increment;
+        };
+
+        static const unsigned cacheSize = 4;
+
         DSTOffsetCache()
         {
             reset();
@@ -85,16 +108,15 @@ namespace JSC {
         
         void reset()
         {
-            offset = 0.0;
-            start = 0.0;
-            end = -1.0;
-            increment = 0.0;
+            for (unsigned i = 0; i < cacheSize; ++i)
+                entries[i].reset();
+            mostRecentEntry = 0;
+            nextEntryToReplace = 0;
         }
 
-        double offset;
-        double start;
-        double end;
-        double increment;
+        Entry entries[cacheSize];
+        unsigned mostRecentEntry;
+        unsigned nextEntryToReplace;
     };
 
     enum ThreadStackType {
@@ -102,6 +124,40 @@ namespace JSC {
         ThreadStackTypeSmall
     };
 
+    enum TypedArrayType {
+        TypedArrayInt8,
+        TypedArrayUint8,
+        TypedArrayUint8Clamped,
+        TypedArrayInt16,
+        TypedArrayUint16,
+        TypedArrayInt32,
+        TypedArrayUint32,
+        TypedArrayFloat32,
+        TypedArrayTypeCount
+    };
+
+    // Describes an embedder's typed array wrapper class, so that indexed
+    // accesses on it can read and write the backing store directly rather
+    // than going through the wrapper's indexed property getters and setters.
+    struct TypedArrayDescriptor {
+        typedef void* (*StorageFunction)(JSCell*, unsigned& length);
+
+        TypedArrayDescriptor()
+            : m_classInfo(0)
+            , m_storage(0)
+        {
+        }
+
+        TypedArrayDescriptor(const ClassInfo* classInfo, StorageFunction storage)
+            : m_classInfo(classInfo)
+            , m_storage(storage)
+        {
+        }
+
+        const ClassInfo* m_classInfo;
+        StorageFunction m_storage;
+    };
+
     class JSGlobalData : public RefCounted<JSGlobalData> {
     public:
         // WebCore has a one-to-one mapping of threads to JSGlobalDatas;
@@ -269,6 +325,9 @@ namespace JSC {
         HandleSlot allocateLocalHandle() { return heap.allocateLocalHandle(); }
         void clearBuiltinStructures();
 
+        void registerTypedArrayDescriptor(TypedArrayType type, const TypedArrayDescriptor& descriptor) { m_typedArrayDescriptors[type] = descriptor; }
+        const TypedArrayDescriptor& typedArrayDescriptor(TypedArrayType type) const { return m_typedArrayDescriptors[type]; }
+
     private:
         JSGlobalData(GlobalDataType, ThreadStackType);
         static JSGlobalData*& sharedInstanceInternal();
@@ -277,6 +336,7 @@ namespace JSC {
         bool m_canUseJIT;
 #endif
         StackBounds m_stack;
+        TypedArrayDescriptor m_typedArrayDescriptors[TypedArrayTypeCount];
     };
 
     inline HandleSlot allocateGlobalHandle(JSGlobalData& globalData)
@@ -30,9 +30,41 @@
 #include "StringObject.h"
 #include "StringPrototype.h"
 
+#define DUMP_ROPE_STATISTICS 0
+
 namespace JSC {
     
-static const unsigned substringFromRopeCutoff = 4;
+static const unsigned substringFromRopeCutoff = 16;
+
+// Maximum number of rope levels characterAt() will descend before giving up and flattening.
+static const unsigned characterAtRopeDepthCutoff = 32;
+
+#if DUMP_ROPE_STATISTICS
+
+static unsigned numRopesResolved;
+static unsigned long long numCharactersResolved;
+static unsigned numRopeCharacterAccesses;
+static unsigned numRopeSearches;
+static unsigned numRopeComparisons;
+static unsigned numRopeSubstrings;
+
+struct RopeStatisticsExitLogger {
+    ~RopeStatisticsExitLogger();
+};
+
+static RopeStatisticsExitLogger logger;
+
+RopeStatisticsExitLogger::~RopeStatisticsExitLogger()
+{
+    printf("\nJSC::JSString rope statistics\n\n");
+    printf("%u ropes resolved (%llu characters)\n", numRopesResolved, numCharactersResolved);
+    printf("%u character accesses on ropes\n", numRopeCharacterAccesses);
+    printf("%u searches on ropes\n", numRopeSearches);
+    printf("%u comparisons involving ropes\n", numRopeComparisons);
+    printf("%u substrings of ropes\n", numRopeSubstrings);
+}
+
+#endif
 
 // Overview: this methods converts a JSString from holding a string in rope form
 // down to a simple UString representation.  It does so by building up the string
@@ -48,6 +80,11 @@ void JSString::resolveRope(ExecState* exec) const
 {
     ASSERT(isRope());
 
+#if DUMP_ROPE_STATISTICS
+    ++numRopesResolved;
+    numCharactersResolved += m_length;
+#endif
+
     // Allocate the buffer to hold the final string, position initially points to the end.
     UChar* buffer;
     if (PassRefPtr<StringImpl> newImpl = StringImpl::tryCreateUninitialized(m_length, buffer))
@@ -118,10 +155,13 @@ JSString* JSString::substringFromRope(ExecState* exec, unsigned substringStart,
     
     JSGlobalData* globalData = &exec->globalData();
 
-    UString substringFibers[3];
+#if DUMP_ROPE_STATISTICS
+    ++numRopeSubstrings;
+#endif
+
+    Vector<UString, s_maxInternalRopeLength> substringFibers;
     
     unsigned fiberCount = 0;
-    unsigned substringFiberCount = 0;
     unsigned substringEnd = substringStart + substringLength;
     unsigned fiberEnd = 0;
 
@@ -136,18 +176,19 @@ JSString* JSString::substringFromRope(ExecState* exec, unsigned substringStart,
         unsigned copyStart = std::max(substringStart, fiberStart);
         unsigned copyEnd = std::min(substringEnd, fiberEnd);
         if (copyStart == fiberStart && copyEnd == fiberEnd)
-            substringFibers[substringFiberCount++] = UString(fiberString);
+            substringFibers.append(UString(fiberString));
         else
-            substringFibers[substringFiberCount++] = UString(StringImpl::create(fiberString, copyStart - fiberStart, copyEnd - copyStart));
+            substringFibers.append(UString(StringImpl::create(fiberString, copyStart - fiberStart, copyEnd - copyStart)));
         if (fiberEnd >= substringEnd)
             break;
-        if (fiberCount > substringFromRopeCutoff || substringFiberCount >= 3) {
+        if (fiberCount > substringFromRopeCutoff) {
             // This turned out to be a really inefficient rope. Just flatten it.
             resolveRope(exec);
             return jsSubstring(&exec->globalData(), m_value, substringStart, substringLength);
         }
     }
-    ASSERT(substringFiberCount && substringFiberCount <= 3);
+    unsigned substringFiberCount = substringFibers.size();
+    ASSERT(substringFiberCount);
 
     if (substringLength == 1) {
         ASSERT(substringFiberCount == 1);
@@ -159,7 +200,155 @@ JSString* JSString::substringFromRope(ExecState* exec, unsigned substringStart,
         return new (globalData) JSString(globalData, substringFibers[0]);
     if (substringFiberCount == 2)
         return new (globalData) JSString(globalData, substringFibers[0], substringFibers[1]);
-    return new (globalData) JSString(globalData, substringFibers[0], substringFibers[1], substringFibers[2]);
+    if (substringFiberCount == 3)
+        return new (globalData) JSString(globalData, substringFibers[0], substringFibers[1], substringFibers[2]);
+
+    // Too many fibers to hold inline, so the substring becomes a rope of its own.
+    RopeBuilder builder(substringFiberCount);
+    if (UNLIKELY(builder.isOutOfMemory())) {
+        throwOutOfMemoryError(exec);
+        return jsEmptyString(globalData);
+    }
+    for (unsigned i = 0; i < substringFiberCount; ++i)
+        builder.append(substringFibers[i]);
+    return new (globalData) JSString(globalData, builder.release());
+}
+
+UChar JSString::characterAtSlowCase(ExecState* exec, unsigned i)
+{
+    ASSERT(isRope());
+    ASSERT(i < m_length);
+
+#if DUMP_ROPE_STATISTICS
+    ++numRopeCharacterAccesses;
+#endif
+
+    // Descend towards the fiber holding the character, skipping whole sub-ropes by their length.
+    // Ropes built by repeated appends are deep on the left, so give up and flatten if the walk
+    // gets long; afterwards every access is constant time.
+    RopeImpl::Fiber* fibers = m_other.m_fibers.data();
+    unsigned offset = i;
+    for (unsigned depth = 0; depth < characterAtRopeDepthCutoff; ++depth) {
+        unsigned index = 0;
+        while (offset >= fibers[index]->length()) {
+            offset -= fibers[index]->length();
+            ++index;
+        }
+        RopeImpl::Fiber fiber = fibers[index];
+        if (!RopeImpl::isRope(fiber))
+            return static_cast<StringImpl*>(fiber)->characters()[offset];
+        RopeImpl* rope = static_cast<RopeImpl*>(fiber);
+        fibers = rope->fibers();
+    }
+
+    resolveRope(exec);
+    if (exec->hadException())
+        return 0;
+    ASSERT(i < m_value.length());
+    return m_value.characters()[i];
+}
+
+static bool matchesAcrossFibers(JSString::RopeIterator it, unsigned offset, const UChar* pattern, unsigned patternLength)
+{
+    JSString::RopeIterator end;
+    unsigned matched = 0;
+    while (true) {
+        StringImpl* fiberString = *it;
+        unsigned length = std::min(fiberString->length() - offset, patternLength - matched);
+        if (memcmp(fiberString->characters() + offset, pattern + matched, length * sizeof(UChar)))
+            return false;
+        matched += length;
+        if (matched == patternLength)
+            return true;
+        ++it;
+        if (!(it != end))
+            return false;
+        offset = 0;
+    }
+}
+
+// Searches the fibers of a rope in order. A match is either found entirely within one fiber,
+// or starts in the last few characters of a fiber and continues into the following ones.
+size_t JSString::indexOfSlowCase(const UString& pattern, unsigned start)
+{
+    ASSERT(isRope());
+
+#if DUMP_ROPE_STATISTICS
+    ++numRopeSearches;
+#endif
+
+    unsigned patternLength = pattern.length();
+    if (!patternLength)
+        return std::min(start, m_length);
+    if (patternLength > m_length || start > m_length - patternLength)
+        return notFound;
+
+    const UChar* patternCharacters = pattern.characters();
+    unsigned fiberEnd = 0;
+
+    RopeIterator end;
+    for (RopeIterator it(m_other.m_fibers.data(), m_fiberCount); it != end; ++it) {
+        StringImpl* fiberString = *it;
+        unsigned fiberLength = fiberString->length();
+        unsigned fiberStart = fiberEnd;
+        fiberEnd = fiberStart + fiberLength;
+        if (fiberEnd <= start)
+            continue;
+
+        unsigned searchStart = start > fiberStart ? start - fiberStart : 0;
+        size_t match = fiberString->find(pattern.impl(), searchStart);
+        if (match != notFound)
+            return fiberStart + match;
+
+        if (patternLength == 1)
+            continue;
+        unsigned candidate = fiberLength >= patternLength ? fiberLength - patternLength + 1 : 0;
+        if (candidate < searchStart)
+            candidate = searchStart;
+        const UChar* fiberCharacters = fiberString->characters();
+        for (; candidate < fiberLength; ++candidate) {
+            if (fiberCharacters[candidate] == patternCharacters[0] && matchesAcrossFibers(it, candidate, patternCharacters, patternLength))
+                return fiberStart + candidate;
+        }
+    }
+    return notFound;
+}
+
+bool JSString::equalSlowCase(JSString* s1, JSString* s2)
+{
+    ASSERT(s1->isRope() || s2->isRope());
+    ASSERT(s1->length() == s2->length());
+
+#if DUMP_ROPE_STATISTICS
+    ++numRopeComparisons;
+#endif
+
+    RopeImpl::Fiber value1 = s1->m_value.impl();
+    RopeImpl::Fiber value2 = s2->m_value.impl();
+    RopeIterator it1 = s1->isRope() ? RopeIterator(s1->m_other.m_fibers.data(), s1->m_fiberCount) : RopeIterator(&value1, 1);
+    RopeIterator it2 = s2->isRope() ? RopeIterator(s2->m_other.m_fibers.data(), s2->m_fiberCount) : RopeIterator(&value2, 1);
+    unsigned offset1 = 0;
+    unsigned offset2 = 0;
+
+    RopeIterator end;
+    while (it1 != end && it2 != end) {
+        StringImpl* string1 = *it1;
+        StringImpl* string2 = *it2;
+        unsigned length = std::min(string1->length() - offset1, string2->length() - offset2);
+        if (memcmp(string1->characters() + offset1, string2->characters() + offset2, length * sizeof(UChar)))
+            return false;
+        offset1 += length;
+        offset2 += length;
+        if (offset1 == string1->length()) {
+            ++it1;
+            offset1 = 0;
+        }
+        if (offset2 == string2->length()) {
+            ++it2;
+            offset2 = 0;
+        }
+    }
+    return true;
 }
 
 JSValue JSString::replaceCharacter(ExecState* exec, UChar character, const UString& replacement)
@@ -217,13 +406,11 @@ JSValue JSString::replaceCharacter(ExecState* exec, UChar character, const UStri
 JSString* JSString::getIndexSlowCase(ExecState* exec, unsigned i)
 {
     ASSERT(isRope());
-    resolveRope(exec);
+    UChar c = characterAtSlowCase(exec, i);
     // Return a safe no-value result, this should never be used, since the excetion will be thrown.
     if (exec->exception())
         return jsString(exec, "");
-    ASSERT(!isRope());
-    ASSERT(i < m_value.length());
-    return jsSingleCharacterSubstring(exec, m_value, i);
+    return jsSingleCharacterString(exec, c);
 }
 
 JSValue JSString::toPrimitive(ExecState*, PreferredPrimitiveType) const
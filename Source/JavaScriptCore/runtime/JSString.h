@@ -347,6 +347,11 @@ namespace JSC {
         JSString* getIndex(ExecState*, unsigned);
         JSString* getIndexSlowCase(ExecState*, unsigned);
 
+        // These operate on ropes without flattening them where possible.
+        UChar characterAt(ExecState*, unsigned);
+        size_t indexOf(const UString& pattern, unsigned start);
+        static bool equal(JSString*, JSString*);
+
         JSValue replaceCharacter(ExecState*, UChar, const UString& replacement);
 
         static Structure* createStructure(JSGlobalData& globalData, JSValue proto) { return Structure::create(globalData, proto, TypeInfo(StringType, OverridesGetOwnPropertySlot | NeedsThisConversion), AnonymousSlotCount, 0); }
@@ -360,6 +365,9 @@ namespace JSC {
 
         void resolveRope(ExecState*) const;
         JSString* substringFromRope(ExecState*, unsigned offset, unsigned length);
+        UChar characterAtSlowCase(ExecState*, unsigned);
+        size_t indexOfSlowCase(const UString& pattern, unsigned start);
+        static bool equalSlowCase(JSString*, JSString*);
 
         void appendStringInConstruct(unsigned& index, const UString& string)
         {
@@ -505,6 +513,30 @@ namespace JSC {
         return jsSingleCharacterSubstring(exec, m_value, i);
     }
 
+    inline UChar JSString::characterAt(ExecState* exec, unsigned i)
+    {
+        ASSERT(canGetIndex(i));
+        if (isRope())
+            return characterAtSlowCase(exec, i);
+        return m_value.characters()[i];
+    }
+
+    inline size_t JSString::indexOf(const UString& pattern, unsigned start)
+    {
+        if (isRope())
+            return indexOfSlowCase(pattern, start);
+        return m_value.find(pattern, start);
+    }
+
+    inline bool JSString::equal(JSString* s1, JSString* s2)
+    {
+        if (s1->length() != s2->length())
+            return false;
+        if (!s1->isRope() && !s2->isRope())
+            return s1->m_value == s2->m_value;
+        return equalSlowCase(s1, s2);
+    }
+
     inline JSString* jsString(JSGlobalData* globalData, const UString& s)
     {
         int size = s.length();
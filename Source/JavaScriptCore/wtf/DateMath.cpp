@@ -721,12 +721,122 @@ double parseES5DateFromNullTerminatedCharacters(const char* dateString)
     return dateSeconds * msPerSecond;
 }
 
+static inline bool parseFixedWidthNumber(const char*& s, int width, long& result)
+{
+    long value = 0;
+    for (int i = 0; i < width; ++i) {
+        if (!isASCIIDigit(s[i]))
+            return false;
+        value = value * 10 + (s[i] - '0');
+    }
+    s += width;
+    result = value;
+    return true;
+}
+
+// Parses the two fixed layouts that dominate real-world input, namely the output
+// of Date.prototype.toUTCString and HTTP dates:
+//     Sat, 01 Jan 2000 08:00:00 GMT
+// and the output of Date.prototype.toString:
+//     Sat Jan 01 2000 08:00:00 GMT+0100 (CET)
+// Anything else, including inputs this would reject as malformed, yields NaN and
+// is left to the general parser below. For accepted inputs the result is identical
+// to what the general parser computes.
+static double parseCommonDateFromNullTerminatedCharacters(const char* dateString, bool& haveTZ, int& offset)
+{
+    // Weekday, which we ignore.
+    static const char weekdays[] = "sunmontuewedthufrisat";
+    bool isWeekday = false;
+    for (const char* weekday = weekdays; *weekday && !isWeekday; weekday += 3)
+        isWeekday = toASCIILower(dateString[0]) == weekday[0] && toASCIILower(dateString[1]) == weekday[1] && toASCIILower(dateString[2]) == weekday[2];
+    if (!isWeekday)
+        return NaN;
+    dateString += 3;
+    bool utcVariant = *dateString == ',';
+    if (utcVariant)
+        dateString++;
+    if (*dateString++ != ' ')
+        return NaN;
+
+    long day;
+    long month;
+    if (utcVariant) {
+        if (!parseFixedWidthNumber(dateString, 2, day) || *dateString++ != ' ')
+            return NaN;
+        if ((month = findMonth(dateString)) == -1)
+            return NaN;
+        dateString += 3;
+    } else {
+        if ((month = findMonth(dateString)) == -1)
+            return NaN;
+        dateString += 3;
+        if (*dateString++ != ' ' || !parseFixedWidthNumber(dateString, 2, day))
+            return NaN;
+    }
+    if (day < 1 || day > 31)
+        return NaN;
+
+    long year;
+    long hour;
+    long minute;
+    long second;
+    if (*dateString++ != ' ' || !parseFixedWidthNumber(dateString, 4, year))
+        return NaN;
+    if (*dateString++ != ' ' || !parseFixedWidthNumber(dateString, 2, hour))
+        return NaN;
+    if (*dateString++ != ':' || !parseFixedWidthNumber(dateString, 2, minute))
+        return NaN;
+    if (*dateString++ != ':' || !parseFixedWidthNumber(dateString, 2, second))
+        return NaN;
+    if (year < 100 || hour > 23 || minute > 59 || second > 59)
+        return NaN;
+    if (*dateString++ != ' ')
+        return NaN;
+
+    int tzOffset = 0;
+    if (strncasecmp(dateString, "GMT", 3) == 0 || strncasecmp(dateString, "UTC", 3) == 0)
+        dateString += 3;
+    else if (*dateString != '+' && *dateString != '-')
+        return NaN;
+    if (*dateString == '+' || *dateString == '-') {
+        int sign = *dateString++ == '-' ? -1 : 1;
+        long hhmm;
+        if (!parseFixedWidthNumber(dateString, 4, hhmm))
+            return NaN;
+        // Same limit as the general parser.
+        if (hhmm > 9959)
+            return NaN;
+        tzOffset = ((hhmm / 100) * 60 + (hhmm % 100)) * sign;
+    }
+
+    // An optional trailing comment holding the time zone name.
+    if (*dateString == ' ') {
+        dateString++;
+        if (*dateString++ != '(')
+            return NaN;
+        while (*dateString && *dateString != '(' && *dateString != ')')
+            dateString++;
+        if (*dateString++ != ')')
+            return NaN;
+    }
+    if (*dateString)
+        return NaN;
+
+    haveTZ = true;
+    offset = tzOffset;
+    return ymdhmsToSeconds(year, month + 1, day, hour, minute, second) * msPerSecond;
+}
+
 // Odd case where 'exec' is allowed to be 0, to accomodate a caller in WebCore.
 static double parseDateFromNullTerminatedCharacters(const char* dateString, bool& haveTZ, int& offset)
 {
     haveTZ = false;
     offset = 0;
 
+    double ms = parseCommonDateFromNullTerminatedCharacters(dateString, haveTZ, offset);
+    if (!isnan(ms))
+        return ms;
+
     // This parses a date in the form:
     //     Tuesday, 09-Nov-99 23:12:40 GMT
     // or
@@ -1040,7 +1150,17 @@ namespace JSC {
 // If this function is called with NaN it returns NaN.
 static double getDSTOffset(ExecState* exec, double ms, double utcOffset)
 {
-    DSTOffsetCache& cache = exec->globalData().dstOffsetCache;
+    DSTOffsetCache& dstOffsetCache = exec->globalData().dstOffsetCache;
+    for (unsigned i = 0; i < DSTOffsetCache::cacheSize; ++i) {
+        DSTOffsetCache::Entry& entry = dstOffsetCache.entries[i];
+        if (entry.start <= ms && ms <= entry.end) {
+            dstOffsetCache.mostRecentEntry = i;
+            return entry.offset;
+        }
+    }
+
+    // Try to grow the most recently used interval towards the given time.
+    DSTOffsetCache::Entry& cache = dstOffsetCache.entries[dstOffsetCache.mostRecentEntry];
     double start = cache.start;
     double end = cache.end;
 
@@ -1084,14 +1204,19 @@ static double getDSTOffset(ExecState* exec, double ms, double utcOffset)
         }
     }
 
-    // Compute the DST offset for the time and shrink the cache interval
-    // to only contain the time. This allows fast repeated DST offset
-    // computations for the same time.
+    // Compute the DST offset for the time and start a new cache interval
+    // that only contains the time, replacing the entries round-robin. This
+    // allows fast repeated DST offset computations for the same time while
+    // keeping the other intervals around.
     double offset = calculateDSTOffset(ms, utcOffset);
-    cache.offset = offset;
-    cache.start = ms;
-    cache.end = ms;
-    cache.increment = msPerMonth;
+    unsigned replacedEntry = dstOffsetCache.nextEntryToReplace;
+    dstOffsetCache.nextEntryToReplace = (replacedEntry + 1) % DSTOffsetCache::cacheSize;
+    dstOffsetCache.mostRecentEntry = replacedEntry;
+    DSTOffsetCache::Entry& newEntry = dstOffsetCache.entries[replacedEntry];
+    newEntry.offset = offset;
+    newEntry.start = ms;
+    newEntry.end = ms;
+    newEntry.increment = msPerMonth;
     return offset;
 }
 
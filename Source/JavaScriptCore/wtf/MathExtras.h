@@ -30,6 +30,7 @@
 #include <cmath>
 #include <float.h>
 #include <limits>
+#include <stdint.h>
 #include <stdlib.h>
 
 #if OS(SOLARIS)
@@ -255,4 +256,22 @@ using std::isnan;
 using std::signbit;
 #endif
 
+// Typed array stores: NaN and infinities become 0, and other values are
+// truncated and wrapped modulo 2^32 as ToInt32 does before narrowing to T.
+template<typename T> inline T doubleToTypedArrayInteger(double value)
+{
+    if (!isfinite(value))
+        return 0;
+    return static_cast<T>(static_cast<int64_t>(fmod(value, 4294967296.0)));
+}
+
+inline uint8_t doubleToClampedByte(double value)
+{
+    if (isnan(value) || value < 0)
+        return 0;
+    if (value > 255)
+        return 255;
+    return static_cast<uint8_t>(value + 0.5);
+}
+
 #endif // #ifndef WTF_MathExtras_h
@@ -1208,9 +1208,10 @@
 #endif
 
 /* Pick which allocator to use; we only need an executable allocator if the assembler is compiled in.
-   On x86-64 we use a single fixed mmap, on other platforms we mmap on demand. */
+   On x86-64 and Android ARM we use a single fixed mmap, on other platforms we mmap on demand.
+   On ARM the fixed region is 16MB, which also keeps all JIT code within branch range. */
 #if ENABLE(ASSEMBLER)
-#if CPU(X86_64)
+#if CPU(X86_64) || (OS(ANDROID) && CPU(ARM))
 #define ENABLE_EXECUTABLE_ALLOCATOR_FIXED 1
 #else
 #define ENABLE_EXECUTABLE_ALLOCATOR_DEMAND 1
@@ -308,6 +308,7 @@ LOCAL_SRC_FILES := $(LOCAL_SRC_FILES) \
 	html/BaseCheckableInputType.cpp \
 	html/BaseDateAndTimeInputType.cpp \
 	html/BaseTextInputType.cpp \
+	html/parser/BackgroundHTMLTokenizer.cpp \
 	html/ButtonInputType.cpp \
 	html/CheckboxInputType.cpp \
 	html/ClassList.cpp \
@@ -575,6 +576,7 @@ LOCAL_SRC_FILES := $(LOCAL_SRC_FILES) \
 	platform/LocalizedStrings.cpp \
 	platform/Logging.cpp \
 	platform/MIMETypeRegistry.cpp \
+	platform/ParallelWorkerPool.cpp \
 	platform/RuntimeApplicationChecks.cpp \
 	platform/SchemeRegistry.cpp \
 	platform/ScrollAnimator.cpp \
@@ -651,6 +653,7 @@ LOCAL_SRC_FILES := $(LOCAL_SRC_FILES) \
 	platform/graphics/SegmentedFontData.cpp \
 	platform/graphics/SimpleFontData.cpp \
 	platform/graphics/StringTruncator.cpp \
+	platform/graphics/WidthCache.cpp \
 	platform/graphics/WidthIterator.cpp \
 	\
 	platform/graphics/android/AndroidAnimation.cpp \
@@ -865,6 +868,7 @@ LOCAL_SRC_FILES := $(LOCAL_SRC_FILES) \
 	rendering/InlineFlowBox.cpp \
 	rendering/InlineTextBox.cpp \
 	rendering/LayoutState.cpp \
+	rendering/LayoutStatistics.cpp \
 	rendering/PointerEventsHitRules.cpp \
 	rendering/RenderApplet.cpp \
 	rendering/RenderArena.cpp \
@@ -1015,6 +1019,7 @@ LOCAL_SRC_FILES := $(LOCAL_SRC_FILES) \
 	rendering/style/StyleBackgroundData.cpp \
 	rendering/style/StyleBoxData.cpp \
 	rendering/style/StyleCachedImage.cpp \
+	rendering/style/StyleDataInterner.cpp \
 	rendering/style/StyleFlexibleBoxData.cpp \
 	rendering/style/StyleGeneratedImage.cpp \
 	rendering/style/StyleInheritedData.cpp \
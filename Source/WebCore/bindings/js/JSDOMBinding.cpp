@@ -43,8 +43,16 @@
 #include "JSDOMWindowCustom.h"
 #include "JSEventException.h"
 #include "JSExceptionBase.h"
+#include "JSFloat32Array.h"
+#include "JSInt16Array.h"
+#include "JSInt32Array.h"
+#include "JSInt8Array.h"
 #include "JSMainThreadExecState.h"
 #include "JSRangeException.h"
+#include "JSUint16Array.h"
+#include "JSUint32Array.h"
+#include "JSUint8Array.h"
+#include "JSUint8ClampedArray.h"
 #include "JSXMLHttpRequestException.h"
 #include "KURL.h"
 #include "MessagePort.h"
@@ -172,6 +180,33 @@ void markDOMObjectWrapper(MarkStack& markStack, JSGlobalData& globalData, void*
     }
 }
 
+template <class JSTypedArray>
+static void* typedArrayStorage(JSCell* cell, unsigned& length)
+{
+    ASSERT(cell->inherits(&JSTypedArray::s_info));
+    JSTypedArray* wrapper = static_cast<JSTypedArray*>(cell);
+    length = wrapper->impl()->length();
+    return wrapper->impl()->baseAddress();
+}
+
+template <class JSTypedArray>
+static void registerTypedArrayDescriptor(JSGlobalData& globalData, TypedArrayType type)
+{
+    globalData.registerTypedArrayDescriptor(type, TypedArrayDescriptor(&JSTypedArray::s_info, typedArrayStorage<JSTypedArray>));
+}
+
+void registerTypedArrayDescriptors(JSGlobalData& globalData)
+{
+    registerTypedArrayDescriptor<JSInt8Array>(globalData, TypedArrayInt8);
+    registerTypedArrayDescriptor<JSUint8Array>(globalData, TypedArrayUint8);
+    registerTypedArrayDescriptor<JSUint8ClampedArray>(globalData, TypedArrayUint8Clamped);
+    registerTypedArrayDescriptor<JSInt16Array>(globalData, TypedArrayInt16);
+    registerTypedArrayDescriptor<JSUint16Array>(globalData, TypedArrayUint16);
+    registerTypedArrayDescriptor<JSInt32Array>(globalData, TypedArrayInt32);
+    registerTypedArrayDescriptor<JSUint32Array>(globalData, TypedArrayUint32);
+    registerTypedArrayDescriptor<JSFloat32Array>(globalData, TypedArrayFloat32);
+}
+
 static void stringWrapperDestroyed(JSString*, void* context)
 {
     StringImpl* cacheKey = static_cast<StringImpl*>(context);
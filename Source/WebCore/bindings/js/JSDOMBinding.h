@@ -116,6 +116,9 @@ namespace WebCore {
     void markActiveObjectsForContext(JSC::MarkStack&, JSC::JSGlobalData&, ScriptExecutionContext*);
     void markDOMObjectWrapper(JSC::MarkStack&, JSC::JSGlobalData& globalData, void* object);
 
+    // Lets the JIT access typed array storage without going through the wrappers' index getters and setters.
+    void registerTypedArrayDescriptors(JSC::JSGlobalData&);
+
     JSC::Structure* getCachedDOMStructure(JSDOMGlobalObject*, const JSC::ClassInfo*);
     JSC::Structure* cacheDOMStructure(JSDOMGlobalObject*, JSC::Structure*, const JSC::ClassInfo*);
 
@@ -56,6 +56,7 @@ WorkerScriptController::WorkerScriptController(WorkerContext* workerContext)
     , m_executionForbidden(false)
 {
     initNormalWorldClientData(m_globalData.get());
+    registerTypedArrayDescriptors(*m_globalData);
 }
 
 WorkerScriptController::~WorkerScriptController()
@@ -810,6 +810,7 @@ before_rule_opening_brace:
     /* empty */ {
         CSSParser* p = static_cast<CSSParser*>(parser);
         p->markSelectorListEnd();
+        p->deferRuleBodyIfPossible();
     }
   ;
 
@@ -163,6 +163,11 @@ CSSParser::CSSParser(bool strictParsing)
     , m_lastSelectorLineNumber(0)
     , m_allowImportRules(true)
     , m_allowNamespaceDeclarations(true)
+    , m_deferRuleBodies(false)
+    , m_deferAllRuleBodies(false)
+    , m_skipNextRuleBody(false)
+    , m_ruleBodySkipped(false)
+    , m_skippedRuleBodyRange(0, 0)
 {
 #if YYDEBUG > 0
     cssyydebug = 1;
@@ -228,6 +233,10 @@ void CSSParser::setupParser(const char* prefix, const String& string, const char
     resetRuleBodyMarks();
 }
 
+// Below this size parsing everything up front is cheap enough that keeping
+// the source text alive for deferred declarations is not worth it.
+static const unsigned minimumSheetLengthForDeferredRuleBodies = 8 * 1024;
+
 void CSSParser::parseSheet(CSSStyleSheet* sheet, const String& string, int startLineNumber, StyleRuleRangeMap* ruleRangeMap)
 {
 #ifdef ANDROID_INSTRUMENT
@@ -243,7 +252,14 @@ void CSSParser::parseSheet(CSSStyleSheet* sheet, const String& string, int start
 
     m_lineNumber = startLineNumber;
     setupParser("", string, "");
+    // The inspector needs the source ranges of every property, which only
+    // the full parse records.
+    m_deferRuleBodies = !ruleRangeMap && (m_deferAllRuleBodies || string.length() >= minimumSheetLengthForDeferredRuleBodies);
+    if (m_deferRuleBodies)
+        m_sheetText = string;
     cssyyparse(this);
+    m_deferRuleBodies = false;
+    m_sheetText = String();
     m_ruleRangeMap = 0;
     m_currentRuleData = 0;
     m_rule = 0;
@@ -605,6 +621,14 @@ bool CSSParser::parseDeclaration(CSSMutableStyleDeclaration* declaration, const
     return ok;
 }
 
+void CSSParser::parseDeferredDeclaration(CSSMutableStyleDeclaration* declaration, const String& sheetText, unsigned start, unsigned length, bool strict)
+{
+    CSSParser parser(strict);
+    // skipRuleBody() already reported invalid blocks in here to the sheet.
+    parser.m_hadSyntacticallyValidCSSRule = true;
+    parser.parseDeclaration(declaration, sheetText.substring(start, length));
+}
+
 bool CSSParser::parseMediaQuery(MediaList* queries, const String& string)
 {
     if (string.isEmpty())
@@ -6005,6 +6029,9 @@ int CSSParser::lex(void* yylvalWithoutType)
     YYSTYPE* yylval = static_cast<YYSTYPE*>(yylvalWithoutType);
     int length;
 
+    if (m_skipNextRuleBody)
+        skipRuleBody();
+
     lex();
 
     UChar* t = text(&length);
@@ -6407,7 +6434,12 @@ CSSRule* CSSParser::createStyleRule(Vector<OwnPtr<CSSParserSelector> >* selector
         rule->adoptSelectorVector(*selectors);
         if (m_hasFontFaceOnlyValues)
             deleteFontFaceOnlyValues();
-        rule->setDeclaration(CSSMutableStyleDeclaration::create(rule.get(), m_parsedProperties, m_numParsedProperties));
+        if (m_ruleBodySkipped) {
+            ASSERT(!m_numParsedProperties);
+            rule->setDeclaration(CSSMutableStyleDeclaration::create(rule.get()));
+            rule->setDeferredDeclaration(m_sheetText, m_skippedRuleBodyRange.start, m_skippedRuleBodyRange.end - m_skippedRuleBodyRange.start, m_strict);
+        } else
+            rule->setDeclaration(CSSMutableStyleDeclaration::create(rule.get(), m_parsedProperties, m_numParsedProperties));
         result = rule.get();
         m_parsedStyleObjects.append(rule.release());
         if (m_ruleRangeMap) {
@@ -6423,6 +6455,7 @@ CSSRule* CSSParser::createStyleRule(Vector<OwnPtr<CSSParserSelector> >* selector
     resetSelectorListMarks();
     resetRuleBodyMarks();
     clearProperties();
+    m_ruleBodySkipped = false;
     return result;
 }
 
@@ -6600,6 +6633,51 @@ void CSSParser::markSelectorListEnd()
     m_selectorListRange.end = listEnd - m_data;
 }
 
+// Called with the opening brace of a style rule as the lookahead token.
+void CSSParser::deferRuleBodyIfPossible()
+{
+    if (m_deferRuleBodies && token() == '{')
+        m_skipNextRuleBody = true;
+}
+
+// Advances the scanner to the brace that closes the current rule body,
+// leaving that brace to be read next, as if the body were empty. The body
+// is tokenized with the same scanner the full parse uses, so the braces it
+// matches and the line numbers it counts are exactly the parser's.
+void CSSParser::skipRuleBody()
+{
+    m_skipNextRuleBody = false;
+    m_ruleBodySkipped = true;
+    m_skippedRuleBodyRange.start = yytext - m_data + 1;
+
+    unsigned depth = 0;
+    while (true) {
+        lex();
+        if (!token()) {
+            m_skippedRuleBodyRange.end = m_sheetText.length();
+            return;
+        }
+        if (token() == '{') {
+            // A nested block is never valid inside a declaration block, so
+            // the full parse would have reduced it as an invalid block.
+            if (!depth)
+                invalidBlockHit();
+            ++depth;
+        } else if (token() == '}') {
+            if (!depth)
+                break;
+            --depth;
+        }
+    }
+
+    m_skippedRuleBodyRange.end = yytext - m_data;
+
+    // Unread the closing brace.
+    *yy_c_buf_p = yy_hold_char;
+    yy_c_buf_p = yytext;
+    yy_hold_char = *yy_c_buf_p;
+}
+
 void CSSParser::markRuleBodyStart()
 {
     unsigned offset = yytext - m_data;
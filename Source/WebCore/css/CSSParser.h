@@ -61,6 +61,9 @@ namespace WebCore {
         ~CSSParser();
 
         void parseSheet(CSSStyleSheet*, const String&, int startLineNumber = 0, StyleRuleRangeMap* ruleRangeMap = 0);
+        // Makes parseSheet() defer the declaration blocks of all style
+        // rules, whatever the size of the sheet.
+        void setDeferAllRuleBodies(bool defer) { m_deferAllRuleBodies = defer; }
         PassRefPtr<CSSRule> parseRule(CSSStyleSheet*, const String&);
         PassRefPtr<CSSRule> parseKeyframeRule(CSSStyleSheet*, const String&);
         static bool parseValue(CSSMutableStyleDeclaration*, int propId, const String&, bool important, bool strict);
@@ -68,6 +71,7 @@ namespace WebCore {
         static bool parseSystemColor(RGBA32& color, const String&, Document*);
         bool parseColor(CSSMutableStyleDeclaration*, const String&);
         bool parseDeclaration(CSSMutableStyleDeclaration*, const String&, RefPtr<CSSStyleSourceData>* styleSourceData = 0);
+        static void parseDeferredDeclaration(CSSMutableStyleDeclaration*, const String& sheetText, unsigned start, unsigned length, bool strict);
         bool parseMediaQuery(MediaList*, const String&);
 
         Document* document() const;
@@ -262,6 +266,7 @@ namespace WebCore {
         RefPtr<CSSRuleSourceData> m_currentRuleData;
         void markSelectorListStart();
         void markSelectorListEnd();
+        void deferRuleBodyIfPossible();
         void markRuleBodyStart();
         void markRuleBodyEnd();
         void markPropertyStart();
@@ -282,6 +287,8 @@ namespace WebCore {
 
         void setupParser(const char* prefix, const String&, const char* suffix);
 
+        void skipRuleBody();
+
         bool inShorthand() const { return m_inParseShorthand; }
 
         void checkForOrphanedUnits();
@@ -320,6 +327,16 @@ namespace WebCore {
         bool m_allowImportRules;
         bool m_allowNamespaceDeclarations;
 
+        // Large style sheets leave the declaration blocks of style rules
+        // unparsed until the rule is first used. m_sheetText is the source
+        // the deferred ranges refer to.
+        bool m_deferRuleBodies;
+        bool m_deferAllRuleBodies;
+        bool m_skipNextRuleBody;
+        bool m_ruleBodySkipped;
+        SourceRange m_skippedRuleBodyRange;
+        String m_sheetText;
+
         Vector<RefPtr<StyleBase> > m_parsedStyleObjects;
         Vector<RefPtr<CSSRuleList> > m_parsedRuleLists;
         HashSet<CSSParserSelector*> m_floatingSelectors;
@@ -38,6 +38,34 @@ namespace WebCore {
 
 using namespace HTMLNames;
     
+CSSSelector::CSSSelector(const CSSSelector& other)
+    : m_relation(other.m_relation)
+    , m_match(other.m_match)
+    , m_pseudoType(other.m_pseudoType)
+    , m_parsedNth(other.m_parsedNth)
+    , m_isLastInSelectorList(other.m_isLastInSelectorList)
+    , m_isLastInTagHistory(other.m_isLastInTagHistory)
+    , m_hasRareData(other.m_hasRareData)
+    , m_isForPage(other.m_isForPage)
+    , m_deleted(false)
+    , m_tag(other.m_tag)
+{
+    if (!m_hasRareData) {
+        m_data.m_value = other.m_data.m_value;
+        if (m_data.m_value)
+            m_data.m_value->ref();
+        return;
+    }
+    const RareData* otherRareData = other.m_data.m_rareData;
+    m_data.m_rareData = new RareData(otherRareData->m_value);
+    m_data.m_rareData->m_a = otherRareData->m_a;
+    m_data.m_rareData->m_b = otherRareData->m_b;
+    m_data.m_rareData->m_attribute = otherRareData->m_attribute;
+    m_data.m_rareData->m_argument = otherRareData->m_argument;
+    if (otherRareData->m_selectorList)
+        m_data.m_rareData->m_selectorList = adoptPtr(new CSSSelectorList(*otherRareData->m_selectorList));
+}
+
 void CSSSelector::createRareData()
 {
     if (m_hasRareData) 
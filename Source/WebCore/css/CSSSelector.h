@@ -33,7 +33,7 @@ namespace WebCore {
 
     // this class represents a selector for a StyleRule
     class CSSSelector {
-        WTF_MAKE_NONCOPYABLE(CSSSelector); WTF_MAKE_FAST_ALLOCATED;
+        WTF_MAKE_FAST_ALLOCATED;
     public:
         CSSSelector()
             : m_relation(Descendant)
@@ -63,6 +63,9 @@ namespace WebCore {
         {
         }
 
+        // Makes a deep copy, for style sheets that share parsed contents.
+        explicit CSSSelector(const CSSSelector&);
+
         ~CSSSelector()
         {
             if (m_deleted)
@@ -281,6 +284,8 @@ namespace WebCore {
         // FIXME: Remove once http://webkit.org/b/56124 is fixed.
         bool m_deleted                : 1;
 
+        CSSSelector& operator=(const CSSSelector&);
+
         unsigned specificityForOneSelector() const;
         unsigned specificityForPage() const;
         void extractPseudoType() const;
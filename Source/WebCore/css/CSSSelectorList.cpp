@@ -33,6 +33,25 @@ namespace WebCore {
 
 static CSSSelector* const freedSelectorArrayMarker = reinterpret_cast<CSSSelector*>(0xbbadbeef);
 
+CSSSelectorList::CSSSelectorList(const CSSSelectorList& other)
+    : m_selectorArray(0)
+{
+    if (!other.m_selectorArray)
+        return;
+
+    // Keep the allocation scheme deleteSelectors() expects.
+    size_t length = 1;
+    while (!other.m_selectorArray[length - 1].isLastInSelectorList())
+        ++length;
+    if (length == 1) {
+        m_selectorArray = new CSSSelector(*other.m_selectorArray);
+        return;
+    }
+    m_selectorArray = reinterpret_cast<CSSSelector*>(fastMalloc(sizeof(CSSSelector) * length));
+    for (size_t i = 0; i < length; ++i)
+        new (&m_selectorArray[i]) CSSSelector(other.m_selectorArray[i]);
+}
+
 CSSSelectorList::~CSSSelectorList() 
 {
     deleteSelectors();
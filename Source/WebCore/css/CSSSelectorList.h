@@ -33,9 +33,10 @@ namespace WebCore {
 class CSSParserSelector;
     
 class CSSSelectorList {
-    WTF_MAKE_NONCOPYABLE(CSSSelectorList); WTF_MAKE_FAST_ALLOCATED;
+    WTF_MAKE_FAST_ALLOCATED;
 public:
     CSSSelectorList() : m_selectorArray(0) { }
+    explicit CSSSelectorList(const CSSSelectorList&);
     ~CSSSelectorList();
 
     void adopt(CSSSelectorList& list);
@@ -49,6 +50,8 @@ public:
     bool hasUnknownPseudoElements() const;
 
 private:
+    CSSSelectorList& operator=(const CSSSelectorList&);
+
     void deleteSelectors();
 
     // End of a multipart selector is indicated by m_isLastInTagHistory bit in the last item.
@@ -34,6 +34,10 @@ namespace WebCore {
 CSSStyleRule::CSSStyleRule(CSSStyleSheet* parent, int sourceLine)
     : CSSRule(parent)
     , m_sourceLine(sourceLine)
+    , m_deferredDeclarationStart(0)
+    , m_deferredDeclarationLength(0)
+    , m_deferredDeclarationIsStrict(false)
+    , m_hasDeferredDeclaration(false)
 {
 }
 
@@ -89,7 +93,7 @@ String CSSStyleRule::cssText() const
     String result = selectorText();
 
     result += " { ";
-    result += m_style->cssText();
+    result += style()->cssText();
     result += "}";
 
     return result;
@@ -104,12 +108,43 @@ bool CSSStyleRule::parseString(const String& /*string*/, bool /*strict*/)
 void CSSStyleRule::setDeclaration(PassRefPtr<CSSMutableStyleDeclaration> style)
 {
     m_style = style;
+    m_hasDeferredDeclaration = false;
+    m_deferredDeclarationText = String();
+}
+
+void CSSStyleRule::setDeferredDeclaration(const String& sheetText, unsigned start, unsigned length, bool strict)
+{
+    ASSERT(m_style && !m_style->length());
+    m_deferredDeclarationText = sheetText;
+    m_deferredDeclarationStart = start;
+    m_deferredDeclarationLength = length;
+    m_deferredDeclarationIsStrict = strict;
+    m_hasDeferredDeclaration = true;
+}
+
+PassRefPtr<CSSStyleRule> CSSStyleRule::copy(CSSStyleSheet* parent) const
+{
+    ASSERT(m_hasDeferredDeclaration);
+    RefPtr<CSSStyleRule> rule = create(parent, m_sourceLine);
+    CSSSelectorList selectorList(m_selectorList);
+    rule->m_selectorList.adopt(selectorList);
+    rule->setDeclaration(CSSMutableStyleDeclaration::create(rule.get()));
+    rule->setDeferredDeclaration(m_deferredDeclarationText, m_deferredDeclarationStart, m_deferredDeclarationLength, m_deferredDeclarationIsStrict);
+    return rule.release();
+}
+
+void CSSStyleRule::parseDeferredDeclaration() const
+{
+    ASSERT(m_hasDeferredDeclaration);
+    m_hasDeferredDeclaration = false;
+    CSSParser::parseDeferredDeclaration(m_style.get(), m_deferredDeclarationText, m_deferredDeclarationStart, m_deferredDeclarationLength, m_deferredDeclarationIsStrict);
+    m_deferredDeclarationText = String();
 }
 
 void CSSStyleRule::addSubresourceStyleURLs(ListHashSet<KURL>& urls)
 {
-    if (m_style)
-        m_style->addSubresourceStyleURLs(urls);
+    if (style())
+        style()->addSubresourceStyleURLs(urls);
 }
 
 } // namespace WebCore
@@ -43,7 +43,12 @@ public:
     virtual String selectorText() const;
     void setSelectorText(const String&);
 
-    CSSMutableStyleDeclaration* style() const { return m_style.get(); }
+    CSSMutableStyleDeclaration* style() const
+    {
+        if (m_hasDeferredDeclaration)
+            parseDeferredDeclaration();
+        return m_style.get();
+    }
 
     virtual String cssText() const;
 
@@ -53,8 +58,18 @@ public:
     void adoptSelectorVector(Vector<OwnPtr<CSSParserSelector> >& selectors) { m_selectorList.adoptSelectorVector(selectors); }
     void setDeclaration(PassRefPtr<CSSMutableStyleDeclaration>);
 
+    // The declaration block is parsed from sheetText the first time it is
+    // asked for. Until then the declaration is empty.
+    void setDeferredDeclaration(const String& sheetText, unsigned start, unsigned length, bool strict);
+
+    // Copies the selectors and the deferred declaration of a rule in a
+    // shared style sheet.
+    PassRefPtr<CSSStyleRule> copy(CSSStyleSheet* parent) const;
+    void parseDeferredDeclaration() const;
+    bool hasDeferredDeclaration() const { return m_hasDeferredDeclaration; }
+
     const CSSSelectorList& selectorList() const { return m_selectorList; }
-    CSSMutableStyleDeclaration* declaration() { return m_style.get(); }
+    CSSMutableStyleDeclaration* declaration() { return style(); }
 
     virtual void addSubresourceStyleURLs(ListHashSet<KURL>& urls);
 
@@ -72,6 +87,12 @@ private:
     RefPtr<CSSMutableStyleDeclaration> m_style;
     CSSSelectorList m_selectorList;
     int m_sourceLine;
+
+    mutable String m_deferredDeclarationText;
+    unsigned m_deferredDeclarationStart;
+    unsigned m_deferredDeclarationLength;
+    bool m_deferredDeclarationIsStrict;
+    mutable bool m_hasDeferredDeclaration;
 };
 
 } // namespace WebCore
@@ -72,6 +72,7 @@
 #include "Page.h"
 #include "PageGroup.h"
 #include "Pair.h"
+#include "ParallelWorkerPool.h"
 #include "PerspectiveTransformOperation.h"
 #include "QuotesData.h"
 #include "Rect.h"
@@ -101,6 +102,10 @@
 #include <wtf/StdLibExtras.h>
 #include <wtf/Vector.h>
 
+#if !OS(WINDOWS)
+#include <unistd.h>
+#endif
+
 #if USE(PLATFORM_STRATEGIES)
 #include "PlatformStrategies.h"
 #include "VisitedLinkStrategy.h"
@@ -286,6 +291,53 @@ if (id == propID) { \
     return; \
 }
 
+// A selector made only of tag, id, class and attribute presence or equality
+// checks, joined by descendant, child and subselector combinators. It is
+// flattened once into arrays of steps so matching does not walk the
+// CSSSelector chain or go through checkOneSelector. All other selectors are
+// left to the SelectorChecker interpreter.
+class CompiledSelector : public RefCounted<CompiledSelector> {
+public:
+    static PassRefPtr<CompiledSelector> compile(const CSSSelector*);
+
+    // elementStyle and selectorAttrs are only used for the compound that
+    // matches the element itself, as in SelectorChecker::checkSelector.
+    bool matches(Element*, bool documentIsHTML, RenderStyle* elementStyle, HashSet<AtomicStringImpl*>* selectorAttrs) const;
+
+    // Attribute steps may synchronize the style attribute and have to record
+    // dependencies in the element's style, so only selectors without them
+    // can be matched away from the main thread.
+    bool canMatchOffMainThread() const { return m_canMatchOffMainThread; }
+
+private:
+    CompiledSelector() : m_canMatchOffMainThread(true) { }
+
+    struct Step {
+        AtomicStringImpl* localName;
+        AtomicStringImpl* namespaceURI;
+        AtomicStringImpl* value;
+        const CSSSelector* selector;
+        unsigned match : 4; // CSSSelector::Match
+        bool checksLocalName : 1;
+        bool checksNamespace : 1;
+        bool valueIsCaseInsensitiveInHTML : 1;
+    };
+
+    // A run of steps joined by subselector combinators, all of which have to
+    // match the same element.
+    struct Compound {
+        unsigned firstStep;
+        unsigned stepCount;
+        CSSSelector::Relation relation; // To the next compound: Descendant or Child.
+    };
+
+    bool matchesCompound(const Compound&, Element*, bool documentIsHTML, RenderStyle* elementStyle, HashSet<AtomicStringImpl*>* selectorAttrs) const;
+
+    Vector<Step, 2> m_steps;
+    Vector<Compound, 2> m_compounds;
+    bool m_canMatchOffMainThread;
+};
+
 class RuleData {
 public:
     RuleData(CSSStyleRule*, CSSSelector*, unsigned position);
@@ -294,7 +346,22 @@ public:
     CSSStyleRule* rule() const { return m_rule; }
     CSSSelector* selector() const { return m_selector; }
     
-    bool hasFastCheckableSelector() const { return m_hasFastCheckableSelector; }
+    // Compiles the selector the first time it is asked for, so rules that
+    // are never matched do not pay for it. Main thread only.
+    const CompiledSelector* compiledSelector() const
+    {
+        if (!m_selectorCompiled) {
+            m_compiledSelector = CompiledSelector::compile(m_selector);
+            m_selectorCompiled = true;
+        }
+        return m_compiledSelector.get();
+    }
+    // For the matching threads, which run after RuleSet::compileSelectors().
+    const CompiledSelector* existingCompiledSelector() const
+    {
+        ASSERT(m_selectorCompiled);
+        return m_compiledSelector.get();
+    }
     bool hasMultipartSelector() const { return m_hasMultipartSelector; }
     bool hasTopSelectorMatchingHTMLBasedOnRuleHash() const { return m_hasTopSelectorMatchingHTMLBasedOnRuleHash; }
     unsigned specificity() const { return m_specificity; }
@@ -309,9 +376,10 @@ private:
     
     CSSStyleRule* m_rule;
     CSSSelector* m_selector;
+    mutable RefPtr<CompiledSelector> m_compiledSelector;
     unsigned m_specificity;
     unsigned m_position : 29;
-    bool m_hasFastCheckableSelector : 1;
+    mutable bool m_selectorCompiled : 1;
     bool m_hasMultipartSelector : 1;
     bool m_hasTopSelectorMatchingHTMLBasedOnRuleHash : 1;
     // Use plain array instead of a Vector to minimize memory overhead.
@@ -330,11 +398,16 @@ public:
 
     void addStyleRule(CSSStyleRule* item);
     void addRule(CSSStyleRule* rule, CSSSelector* sel);
+    void collectInvalidationFeatures(const CSSSelector*, bool affectsOtherElements);
     void addPageRule(CSSStyleRule* rule, CSSSelector* sel);
     void addToRuleSet(AtomicStringImpl* key, AtomRuleMap& map,
                       CSSStyleRule* rule, CSSSelector* sel);
     void shrinkToFit();
     void disableAutoShrinkToFit() { m_autoShrinkToFitEnabled = false; }
+    // Compiles every selector that has not been compiled yet, so that the
+    // parallel matching threads see the same compiled selectors as the
+    // main thread.
+    void compileSelectors();
 
     void collectFeatures(CSSStyleSelector::Features&) const;
     
@@ -352,8 +425,18 @@ public:
     AtomRuleMap m_pseudoRules;
     Vector<RuleData> m_universalRules;
     Vector<RuleData> m_pageRules;
+
+    // Ids, classes and attribute names used by the selectors in this set. The
+    // value is true if one is used left of a combinator somewhere, so that
+    // changing it on an element can change the style of other elements.
+    typedef HashMap<AtomicStringImpl*, bool> InvalidationFeatureMap;
+    InvalidationFeatureMap m_idsInSelectors;
+    InvalidationFeatureMap m_classesInSelectors;
+    InvalidationFeatureMap m_attrsInSelectors;
+
     unsigned m_ruleCount;
     bool m_autoShrinkToFitEnabled;
+    bool m_selectorsCompiled;
 };
 
 static RuleSet* defaultStyle;
@@ -430,7 +513,8 @@ static CSSMutableStyleDeclaration* rightToLeftDeclaration()
 CSSStyleSelector::CSSStyleSelector(Document* document, StyleSheetList* styleSheets, CSSStyleSheet* mappedElementSheet,
                                    CSSStyleSheet* pageUserSheet, const Vector<RefPtr<CSSStyleSheet> >* pageGroupUserSheets,
                                    bool strictParsing, bool matchAuthorAndUserStyles)
-    : m_backgroundData(BackgroundFillLayer)
+    : m_parallelMatchedRules(0)
+    , m_backgroundData(BackgroundFillLayer)
     , m_checker(document, strictParsing)
     , m_element(0)
     , m_styledElement(0)
@@ -439,6 +523,7 @@ CSSStyleSelector::CSSStyleSelector(Document* document, StyleSheetList* styleShee
     , m_applyProperty(CSSStyleApplyProperty::sharedCSSStyleApplyProperty())
 {
     m_matchAuthorAndUserStyles = matchAuthorAndUserStyles;
+    m_appliedInheritValue = false;
     
     Element* root = document->documentElement();
 
@@ -545,7 +630,9 @@ CSSStyleSelector::Features::~Features()
 static CSSStyleSheet* parseUASheet(const String& str)
 {
     CSSStyleSheet* sheet = CSSStyleSheet::create().releaseRef(); // leak the sheet on purpose
-    sheet->parseString(str);
+    // Most default rules are for elements a given page never uses, so their
+    // declarations are only parsed once a rule first matches.
+    sheet->parseStringWithDeferredRuleBodies(str, true);
     return sheet;
 }
 
@@ -696,6 +783,9 @@ void CSSStyleSelector::matchRules(RuleSet* rules, int& firstRuleIndex, int& last
 
     if (!rules || !m_element)
         return;
+
+    if (rules == m_authorStyle.get() || rules == m_userStyle.get())
+        m_parallelMatchedRules = parallelMatchedRulesForElement();
     
     // We need to collect the rules for id, class, tag, and everything else into a buffer and
     // then sort the buffer.
@@ -714,6 +804,7 @@ void CSSStyleSelector::matchRules(RuleSet* rules, int& firstRuleIndex, int& last
     }
     matchRulesForList(rules->getTagRules(m_element->localName().impl()), firstRuleIndex, lastRuleIndex, includeEmptyRules);
     matchRulesForList(rules->getUniversalRules(), firstRuleIndex, lastRuleIndex, includeEmptyRules);
+    m_parallelMatchedRules = 0;
     
     // If we didn't match any rules, we're done.
     if (m_matchedRules.isEmpty())
@@ -735,17 +826,23 @@ void CSSStyleSelector::matchRules(RuleSet* rules, int& firstRuleIndex, int& last
     }
 }
 
-inline bool CSSStyleSelector::fastRejectSelector(const RuleData& ruleData) const
+template <typename AncestorIdentifierFilter>
+static inline bool ancestorFilterRejectsSelector(const AncestorIdentifierFilter& filter, const RuleData& ruleData)
 {
-    ASSERT(m_ancestorIdentifierFilter);
     const unsigned* descendantSelectorIdentifierHashes = ruleData.descendantSelectorIdentifierHashes();
     for (unsigned n = 0; n < RuleData::maximumIdentifierCount && descendantSelectorIdentifierHashes[n]; ++n) {
-        if (!m_ancestorIdentifierFilter->mayContain(descendantSelectorIdentifierHashes[n]))
+        if (!filter.mayContain(descendantSelectorIdentifierHashes[n]))
             return true;
     }
     return false;
 }
 
+inline bool CSSStyleSelector::fastRejectSelector(const RuleData& ruleData) const
+{
+    ASSERT(m_ancestorIdentifierFilter);
+    return ancestorFilterRejectsSelector(*m_ancestorIdentifierFilter, ruleData);
+}
+
 void CSSStyleSelector::matchRulesForList(const Vector<RuleData>* rules, int& firstRuleIndex, int& lastRuleIndex, bool includeEmptyRules)
 {
     if (!rules)
@@ -787,6 +884,196 @@ void CSSStyleSelector::matchRulesForList(const Vector<RuleData>* rules, int& fir
     }
 }
 
+// When a forced style recalc restyles every child of an element, the
+// compiled selectors that can run off the main thread are matched against
+// those children on several threads before the children are styled in order.
+// Everything else, including the cascade, still runs on the main thread.
+static const size_t minimumChildrenForParallelMatching = 32;
+static const size_t minimumChildrenPerMatchingThread = 16;
+static const size_t maximumParallelMatchingThreads = 4;
+
+class ParallelMatchBatch {
+    WTF_MAKE_NONCOPYABLE(ParallelMatchBatch); WTF_MAKE_FAST_ALLOCATED;
+public:
+    ParallelMatchBatch(Element* parent) : parent(parent) { }
+
+    Element* parent;
+    Vector<Element*> elements;
+    // For each element, the matching rules sorted by address.
+    Vector<Vector<const RuleData*> > matchedRules;
+    HashMap<Element*, unsigned> indexes;
+};
+
+template <typename AncestorIdentifierFilter>
+struct ParallelMatchJob {
+    const RuleSet* authorStyle;
+    const RuleSet* userStyle;
+    const AncestorIdentifierFilter* ancestorIdentifierFilter;
+    bool documentIsHTML;
+    Element* const* elements;
+    Vector<const RuleData*>* matchedRules;
+    size_t count;
+};
+
+static size_t parallelMatchingThreadCount()
+{
+#if OS(WINDOWS)
+    return 1;
+#else
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cores < 2)
+        return 1;
+    return min(static_cast<size_t>(cores), maximumParallelMatchingThreads);
+#endif
+}
+
+template <typename AncestorIdentifierFilter>
+static void collectParallelMatches(const ParallelMatchJob<AncestorIdentifierFilter>& job, const Vector<RuleData>* rules, Element* element, Vector<const RuleData*>& matchedRules)
+{
+    if (!rules)
+        return;
+    unsigned size = rules->size();
+    for (unsigned i = 0; i < size; ++i) {
+        const RuleData& ruleData = rules->at(i);
+        const CompiledSelector* compiledSelector = ruleData.existingCompiledSelector();
+        if (!compiledSelector || !compiledSelector->canMatchOffMainThread())
+            continue;
+        if (job.ancestorIdentifierFilter && ancestorFilterRejectsSelector(*job.ancestorIdentifierFilter, ruleData))
+            continue;
+        if (compiledSelector->matches(element, job.documentIsHTML, 0, 0))
+            matchedRules.append(&ruleData);
+    }
+}
+
+template <typename AncestorIdentifierFilter>
+static void collectParallelMatches(const ParallelMatchJob<AncestorIdentifierFilter>& job, const RuleSet* rules, Element* element, Vector<const RuleData*>& matchedRules)
+{
+    if (!rules)
+        return;
+    // Same lists as CSSStyleSelector::matchRules(). Shadow pseudo-element rules are never compiled.
+    if (element->hasID())
+        collectParallelMatches(job, rules->getIDRules(element->idForStyleResolution().impl()), element, matchedRules);
+    if (element->hasClass()) {
+        const SpaceSplitString& classNames = static_cast<StyledElement*>(element)->classNames();
+        size_t size = classNames.size();
+        for (size_t i = 0; i < size; ++i)
+            collectParallelMatches(job, rules->getClassRules(classNames[i].impl()), element, matchedRules);
+    }
+    collectParallelMatches(job, rules->getTagRules(element->localName().impl()), element, matchedRules);
+    collectParallelMatches(job, rules->getUniversalRules(), element, matchedRules);
+}
+
+template <typename AncestorIdentifierFilter>
+static void runParallelMatchJob(const ParallelMatchJob<AncestorIdentifierFilter>& job)
+{
+    for (size_t i = 0; i < job.count; ++i) {
+        Vector<const RuleData*>& matchedRules = job.matchedRules[i];
+        collectParallelMatches(job, job.authorStyle, job.elements[i], matchedRules);
+        collectParallelMatches(job, job.userStyle, job.elements[i], matchedRules);
+        std::sort(matchedRules.begin(), matchedRules.end());
+    }
+}
+
+template <typename AncestorIdentifierFilter>
+static void runParallelMatchJobFromPool(void* job)
+{
+    runParallelMatchJob(*static_cast<ParallelMatchJob<AncestorIdentifierFilter>*>(job));
+}
+
+static ParallelWorkerPool& parallelMatchingWorkers()
+{
+    // The main thread runs one job itself.
+    DEFINE_STATIC_LOCAL(ParallelWorkerPool, workers, ("WebCore: ParallelSelectorMatching", maximumParallelMatchingThreads - 1));
+    return workers;
+}
+
+bool CSSStyleSelector::matchChildrenInParallel(Element* parent)
+{
+    Settings* settings = m_checker.m_document->settings();
+    if (!settings || !settings->parallelSelectorMatchingEnabled() || !m_matchAuthorAndUserStyles)
+        return false;
+
+    size_t threadCount = parallelMatchingThreadCount();
+    if (threadCount < 2)
+        return false;
+
+    OwnPtr<ParallelMatchBatch> batch = adoptPtr(new ParallelMatchBatch(parent));
+    for (Node* child = parent->firstChild(); child; child = child->nextSibling()) {
+        // SVG elements never take the compiled path, see checkSelector().
+        if (child->isElementNode() && !child->isSVGElement())
+            batch->elements.append(static_cast<Element*>(child));
+    }
+    size_t elementCount = batch->elements.size();
+    if (elementCount < minimumChildrenForParallelMatching)
+        return false;
+    threadCount = min(threadCount, elementCount / minimumChildrenPerMatchingThread);
+
+    // The class name vectors are built lazily out of AtomicStrings, so make sure
+    // every element the compiled selectors can look at has them ready.
+    for (Element* ancestor = parent; ancestor; ancestor = ancestor->parentElement()) {
+        if (ancestor->hasClass())
+            static_cast<StyledElement*>(ancestor)->classNames().size();
+    }
+    for (size_t i = 0; i < elementCount; ++i) {
+        Element* element = batch->elements[i];
+        if (element->hasClass())
+            static_cast<StyledElement*>(element)->classNames().size();
+        batch->indexes.add(element, i);
+    }
+    batch->matchedRules.resize(elementCount);
+
+    // Selectors are otherwise compiled on first use, which the matching
+    // threads must not do.
+    if (m_authorStyle)
+        m_authorStyle->compileSelectors();
+    if (m_userStyle)
+        m_userStyle->compileSelectors();
+
+    typedef BloomFilter<bloomFilterKeyBits> AncestorIdentifierFilter;
+    bool canUseFastReject = !m_parentStack.isEmpty() && m_parentStack.last().element == parent;
+    Vector<ParallelMatchJob<AncestorIdentifierFilter>, maximumParallelMatchingThreads> jobs;
+    size_t chunkSize = (elementCount + threadCount - 1) / threadCount;
+    for (size_t start = 0; start < elementCount; start += chunkSize) {
+        ParallelMatchJob<AncestorIdentifierFilter> job;
+        job.authorStyle = m_authorStyle.get();
+        job.userStyle = m_userStyle.get();
+        job.ancestorIdentifierFilter = canUseFastReject ? m_ancestorIdentifierFilter.get() : 0;
+        job.documentIsHTML = m_checker.m_documentIsHTML;
+        job.elements = batch->elements.data() + start;
+        job.matchedRules = batch->matchedRules.data() + start;
+        job.count = min(chunkSize, elementCount - start);
+        jobs.append(job);
+    }
+
+    // This thread runs jobs too. The DOM and the rule sets are not touched
+    // by anyone else until all jobs are done.
+    parallelMatchingWorkers().run(runParallelMatchJobFromPool<AncestorIdentifierFilter>, jobs);
+
+    m_parallelMatchBatches.append(batch.release());
+    return true;
+}
+
+void CSSStyleSelector::finishParallelMatching(Element* parent)
+{
+    ASSERT_UNUSED(parent, !m_parallelMatchBatches.isEmpty() && m_parallelMatchBatches.last()->parent == parent);
+    m_parallelMatchBatches.removeLast();
+}
+
+const Vector<const RuleData*>* CSSStyleSelector::parallelMatchedRulesForElement() const
+{
+    if (m_parallelMatchBatches.isEmpty())
+        return 0;
+    // Children are styled depth first, so an element can only have been
+    // matched as part of the innermost batch.
+    const ParallelMatchBatch* batch = m_parallelMatchBatches.last().get();
+    if (m_element->parentNode() != batch->parent)
+        return 0;
+    HashMap<Element*, unsigned>::const_iterator it = batch->indexes.find(m_element);
+    if (it == batch->indexes.end())
+        return 0;
+    return &batch->matchedRules[it->second];
+}
+
 static inline bool compareRules(const RuleData* r1, const RuleData* r2)
 {
     unsigned specificity1 = r1->specificity();
@@ -1441,6 +1728,50 @@ PassRefPtr<RenderStyle> CSSStyleSelector::styleForElement(Element* e, RenderStyl
     // Reset the value back before applying properties, so that -webkit-link knows what color to use.
     m_checker.m_matchVisitedPseudoClass = matchVisitedPseudoClass;
     
+    MatchedRuleRanges ruleRanges = { firstUARule, lastUARule, firstUserRule, lastUserRule, firstAuthorRule, lastAuthorRule };
+    unsigned cacheHash = canUseMatchedDeclarationsCache(e, visitedStyle.get(), resolveForRootDefault, matchVisitedPseudoClass) ? computeMatchedDeclarationsHash() : 0;
+    const MatchedDeclarationsCacheItem* cacheItem = cacheHash ? findFromMatchedDeclarationsCache(cacheHash, ruleRanges) : 0;
+    if (cacheItem) {
+        // The same declarations on top of the same inherited data give the same style.
+        m_style->copyNonInheritedFrom(cacheItem->renderStyle.get());
+        m_style->inheritFrom(cacheItem->renderStyle.get());
+        cacheBorderAndBackground();
+    } else
+        applyMatchedDeclarations(ruleRanges, resolveForRootDefault);
+
+    // Start loading images referenced by this style.
+    loadPendingImages();
+
+    if (cacheHash && !cacheItem)
+        addToMatchedDeclarationsCache(cacheHash, ruleRanges);
+
+    // Clean up our style object's display and text decorations (among other fixups).
+    adjustRenderStyle(style(), m_parentStyle, e);
+
+    // If we have first-letter pseudo style, do not share this style
+    if (m_style->hasPseudoStyle(FIRST_LETTER))
+        m_style->setUnique();
+
+    if (visitedStyle) {
+        // Add the visited style off the main style.
+        m_style->addCachedPseudoStyle(visitedStyle.release());
+    }
+
+    // Equal groups resolved for other elements are shared rather than
+    // kept as separate copies.
+    m_style->internData();
+
+    if (!matchVisitedPseudoClass)
+        initElement(0); // Clear out for the next resolve.
+
+    // Now return the style.
+    return m_style.release();
+}
+
+void CSSStyleSelector::applyMatchedDeclarations(const MatchedRuleRanges& ruleRanges, bool resolveForRootDefault)
+{
+    m_appliedInheritValue = false;
+
     // Now we have all of the matched rules in the appropriate order.  Walk the rules and apply
     // high-priority properties first, i.e., those properties that other properties depend on.
     // The order is (1) high-priority not important, (2) high-priority important, (3) normal not important
@@ -1448,10 +1779,10 @@ PassRefPtr<RenderStyle> CSSStyleSelector::styleForElement(Element* e, RenderStyl
     m_lineHeightValue = 0;
     applyDeclarations<true>(false, 0, m_matchedDecls.size() - 1);
     if (!resolveForRootDefault) {
-        applyDeclarations<true>(true, firstAuthorRule, lastAuthorRule);
-        applyDeclarations<true>(true, firstUserRule, lastUserRule);
+        applyDeclarations<true>(true, ruleRanges.firstAuthorRule, ruleRanges.lastAuthorRule);
+        applyDeclarations<true>(true, ruleRanges.firstUserRule, ruleRanges.lastUserRule);
     }
-    applyDeclarations<true>(true, firstUARule, lastUARule);
+    applyDeclarations<true>(true, ruleRanges.firstUARule, ruleRanges.lastUARule);
     
     // If our font got dirtied, go ahead and update it now.
     if (m_fontDirty)
@@ -1462,45 +1793,98 @@ PassRefPtr<RenderStyle> CSSStyleSelector::styleForElement(Element* e, RenderStyl
         applyProperty(CSSPropertyLineHeight, m_lineHeightValue);
 
     // Now do the normal priority UA properties.
-    applyDeclarations<false>(false, firstUARule, lastUARule);
+    applyDeclarations<false>(false, ruleRanges.firstUARule, ruleRanges.lastUARule);
     
     // Cache our border and background so that we can examine them later.
     cacheBorderAndBackground();
     
     // Now do the author and user normal priority properties and all the !important properties.
     if (!resolveForRootDefault) {
-        applyDeclarations<false>(false, lastUARule + 1, m_matchedDecls.size() - 1);
-        applyDeclarations<false>(true, firstAuthorRule, lastAuthorRule);
-        applyDeclarations<false>(true, firstUserRule, lastUserRule);
+        applyDeclarations<false>(false, ruleRanges.lastUARule + 1, m_matchedDecls.size() - 1);
+        applyDeclarations<false>(true, ruleRanges.firstAuthorRule, ruleRanges.lastAuthorRule);
+        applyDeclarations<false>(true, ruleRanges.firstUserRule, ruleRanges.lastUserRule);
     }
-    applyDeclarations<false>(true, firstUARule, lastUARule);
+    applyDeclarations<false>(true, ruleRanges.firstUARule, ruleRanges.lastUARule);
 
     ASSERT(!m_fontDirty);
     // If our font got dirtied by one of the non-essential font props, 
     // go ahead and update it a second time.
     if (m_fontDirty)
         updateFont();
-    
-    // Clean up our style object's display and text decorations (among other fixups).
-    adjustRenderStyle(style(), m_parentStyle, e);
+}
 
-    // Start loading images referenced by this style.
-    loadPendingImages();
+static const int maximumMatchedDeclarationsCacheSize = 1024;
 
-    // If we have first-letter pseudo style, do not share this style
-    if (m_style->hasPseudoStyle(FIRST_LETTER))
-        m_style->setUnique();
+bool CSSStyleSelector::canUseMatchedDeclarationsCache(Element* e, RenderStyle* visitedStyle, bool resolveForRootDefault, bool matchVisitedPseudoClass) const
+{
+    if (resolveForRootDefault || matchVisitedPseudoClass || visitedStyle)
+        return false;
+    // Without a parent there is no inherited data to key on.
+    if (!m_parentStyle || m_parentStyle == m_style.get())
+        return false;
+    // The root sets document-wide state while applying, links depend on their
+    // visited state, SVG elements resolve lengths differently and WAP form
+    // controls pick up state from applyProperty().
+    if (e == e->document()->documentElement() || e->isLink() || e->isSVGElement() || e->isFormControlElement())
+        return false;
+    // Inline style is mutated in place, so its address does not identify its contents.
+    if (m_styledElement && m_styledElement->inlineStyleDecl())
+        return false;
+    // rem units depend on the root element rather than the parent.
+    if (e->document()->usesRemUnits())
+        return false;
+    return true;
+}
 
-    if (visitedStyle) {
-        // Add the visited style off the main style.
-        m_style->addCachedPseudoStyle(visitedStyle.release());
+unsigned CSSStyleSelector::computeMatchedDeclarationsHash() const
+{
+    unsigned hash = StringHasher::hashMemory(m_matchedDecls.data(), m_matchedDecls.size() * sizeof(CSSMutableStyleDeclaration*));
+    // Zero and -1 are the empty and deleted values of the cache's hash table.
+    if (!hash || hash == std::numeric_limits<unsigned>::max())
+        hash = 1;
+    return hash;
+}
+
+const CSSStyleSelector::MatchedDeclarationsCacheItem* CSSStyleSelector::findFromMatchedDeclarationsCache(unsigned hash, const MatchedRuleRanges& ruleRanges) const
+{
+    MatchedDeclarationsCache::const_iterator it = m_matchedDeclarationsCache.find(hash);
+    if (it == m_matchedDeclarationsCache.end())
+        return 0;
+    const MatchedDeclarationsCacheItem& cacheItem = it->second;
+
+    if (cacheItem.ruleRanges != ruleRanges)
+        return 0;
+    size_t size = m_matchedDecls.size();
+    if (size != cacheItem.declarations.size())
+        return 0;
+    for (size_t i = 0; i < size; ++i) {
+        if (m_matchedDecls[i] != cacheItem.declarations[i])
+            return 0;
     }
+    if (!m_parentStyle->inheritedDataShared(cacheItem.parentRenderStyle.get()))
+        return 0;
+    return &cacheItem;
+}
 
-    if (!matchVisitedPseudoClass)
-        initElement(0); // Clear out for the next resolve.
+void CSSStyleSelector::addToMatchedDeclarationsCache(unsigned hash, const MatchedRuleRanges& ruleRanges)
+{
+    // Styles that depend on the element itself or on the parent's
+    // non-inherited data cannot be reused for another element.
+    if (m_style->unique() || m_style->hasAppearance() || m_appliedInheritValue)
+        return;
 
-    // Now return the style.
-    return m_style.release();
+    if (m_matchedDeclarationsCache.size() >= maximumMatchedDeclarationsCacheSize)
+        m_matchedDeclarationsCache.clear();
+
+    MatchedDeclarationsCacheItem cacheItem;
+    cacheItem.declarations.reserveInitialCapacity(m_matchedDecls.size());
+    for (size_t i = 0; i < m_matchedDecls.size(); ++i)
+        cacheItem.declarations.uncheckedAppend(m_matchedDecls[i]);
+    cacheItem.ruleRanges = ruleRanges;
+    // The style keeps being changed for this element after this point, so keep a copy.
+    cacheItem.renderStyle = RenderStyle::clone(m_style.get());
+    cacheItem.parentRenderStyle = m_parentStyle;
+    m_matchedDeclarationsCache.set(hash, cacheItem);
 }
 
 PassRefPtr<RenderStyle> CSSStyleSelector::styleForKeyframe(const RenderStyle* elementStyle, const WebKitCSSKeyframeRule* keyframeRule, KeyframeValue& keyframe)
@@ -2043,15 +2427,20 @@ inline bool CSSStyleSelector::checkSelector(const RuleData& ruleData)
     m_dynamicPseudo = NOPSEUDO;
 
     // Let the slow path handle SVG as it has some additional rules regarding shadow trees.
-    if (ruleData.hasFastCheckableSelector() && !m_element->isSVGElement()) {
-        // We know this selector does not include any pseudo selectors.
-        if (m_checker.m_pseudoStyle != NOPSEUDO)
-            return false;
+    if (!m_element->isSVGElement()) {
         // We know a sufficiently simple single part selector matches simply because we found it from the rule hash.
-        // This is limited to HTML only so we don't need to check the namespace.
+        // This is limited to HTML only so we don't need to check the namespace. Such a selector always compiles,
+        // so it does not include any pseudo selectors either.
         if (ruleData.hasTopSelectorMatchingHTMLBasedOnRuleHash() && !ruleData.hasMultipartSelector() && m_element->isHTMLElement())
-            return true;
-        return SelectorChecker::fastCheckSelector(ruleData.selector(), m_element);
+            return m_checker.m_pseudoStyle == NOPSEUDO;
+        if (const CompiledSelector* compiledSelector = ruleData.compiledSelector()) {
+            // We know this selector does not include any pseudo selectors.
+            if (m_checker.m_pseudoStyle != NOPSEUDO)
+                return false;
+            if (m_parallelMatchedRules && compiledSelector->canMatchOffMainThread())
+                return std::binary_search(m_parallelMatchedRules->begin(), m_parallelMatchedRules->end(), &ruleData);
+            return compiledSelector->matches(m_element, m_checker.m_documentIsHTML, style(), &m_selectorAttrs);
+        }
     }
 
     // Slow path.
@@ -2074,111 +2463,6 @@ static inline bool selectorTagMatches(const Element* element, const CSSSelector*
     return namespaceURI == starAtom || namespaceURI == element->namespaceURI();
 }
 
-static inline bool isFastCheckableSelector(const CSSSelector* selector)
-{
-    for (; selector; selector = selector->tagHistory()) {
-        if (selector->relation() != CSSSelector::Descendant && selector->relation() != CSSSelector::Child && selector->relation() != CSSSelector::SubSelector)
-            return false;
-        if (selector->m_match != CSSSelector::None && selector->m_match != CSSSelector::Id && selector->m_match != CSSSelector::Class)
-            return false;
-    }
-    return true;
-}
-    
-template <class ValueChecker>
-inline bool fastCheckSingleSelector(const CSSSelector*& selector, const Element*& element, const CSSSelector*& topChildOrSubselector, const Element*& topChildOrSubselectorMatchElement)
-{
-    AtomicStringImpl* value = selector->value().impl();
-    for (; element; element = element->parentElement()) {
-        if (ValueChecker::checkValue(element, value) && selectorTagMatches(element, selector)) {
-            if (selector->relation() == CSSSelector::Descendant)
-                topChildOrSubselector = 0;
-            else if (!topChildOrSubselector) {
-                ASSERT(selector->relation() == CSSSelector::Child || selector->relation() == CSSSelector::SubSelector);
-                topChildOrSubselector = selector;
-                topChildOrSubselectorMatchElement = element;
-            }
-            if (selector->relation() != CSSSelector::SubSelector)
-                element = element->parentElement();
-            selector = selector->tagHistory();
-            return true;
-        }
-        if (topChildOrSubselector) {
-            // Child or subselector check failed.
-            // If the match element is null, topChildOrSubselector was also the very topmost selector and had to match 
-            // the original element we were checking.
-            if (!topChildOrSubselectorMatchElement)
-                return false;
-            // There may be other matches down the ancestor chain.
-            // Rewind to the topmost child or subselector and the element it matched, continue checking ancestors.
-            selector = topChildOrSubselector;
-            element = topChildOrSubselectorMatchElement->parentElement();
-            topChildOrSubselector = 0;
-            return true;
-        }
-    }
-    return false;
-}
-
-struct ClassCheck {
-    static bool checkValue(const Element* element, AtomicStringImpl* value) 
-    {
-        return element->hasClass() && static_cast<const StyledElement*>(element)->classNames().contains(value);
-    }
-};
-struct IdCheck {
-    static bool checkValue(const Element* element, AtomicStringImpl* value) 
-    {
-        return element->hasID() && element->idForStyleResolution().impl() == value;
-    }
-};
-struct TagCheck {
-    static bool checkValue(const Element*, AtomicStringImpl*)
-    {
-        return true;
-    }
-};
-
-bool CSSStyleSelector::SelectorChecker::fastCheckSelector(const CSSSelector* selector, const Element* element)
-{
-    ASSERT(isFastCheckableSelector(selector));
-
-    // The top selector requires tag check only as rule hashes have already handled id and class matches.
-    if (!selectorTagMatches(element, selector))
-        return false;
-
-    const CSSSelector* topChildOrSubselector = 0;
-    const Element* topChildOrSubselectorMatchElement = 0;
-    if (selector->relation() == CSSSelector::Child || selector->relation() == CSSSelector::SubSelector)
-        topChildOrSubselector = selector;
-
-    if (selector->relation() != CSSSelector::SubSelector)
-        element = element->parentElement();
-
-    selector = selector->tagHistory();
-
-    // We know this compound selector has descendant, child and subselector combinators only and all components are simple.
-    while (selector) {
-        switch (selector->m_match) {
-        case CSSSelector::Class:
-            if (!fastCheckSingleSelector<ClassCheck>(selector, element, topChildOrSubselector, topChildOrSubselectorMatchElement))
-                return false;
-            break;
-        case CSSSelector::Id:
-            if (!fastCheckSingleSelector<IdCheck>(selector, element, topChildOrSubselector, topChildOrSubselectorMatchElement))
-                return false;
-            break;
-        case CSSSelector::None:
-            if (!fastCheckSingleSelector<TagCheck>(selector, element, topChildOrSubselector, topChildOrSubselectorMatchElement))
-                return false;
-            break;
-        default:
-            ASSERT_NOT_REACHED();
-        }
-    }
-    return true;
-}
-
 // Recursive check of selectors and combinators
 // It can return 3 different values:
 // * SelectorMatches         - the selector matches the element e
@@ -2364,6 +2648,160 @@ static bool htmlAttributeHasCaseInsensitiveValue(const QualifiedName& attr)
     return isPossibleHTMLAttr && htmlCaseInsensitiveAttributesSet->contains(attr.localName().impl());
 }
 
+PassRefPtr<CompiledSelector> CompiledSelector::compile(const CSSSelector* selector)
+{
+    RefPtr<CompiledSelector> compiled = adoptRef(new CompiledSelector);
+    Compound compound = { 0, 0, CSSSelector::Descendant };
+    for (; selector; selector = selector->tagHistory()) {
+        Step step;
+        step.localName = 0;
+        step.namespaceURI = 0;
+        step.value = 0;
+        step.selector = selector;
+        step.match = selector->m_match;
+        step.checksLocalName = false;
+        step.checksNamespace = false;
+        step.valueIsCaseInsensitiveInHTML = false;
+
+        switch (selector->m_match) {
+        case CSSSelector::None:
+            break;
+        case CSSSelector::Id:
+        case CSSSelector::Class:
+            step.value = selector->value().impl();
+            break;
+        case CSSSelector::Set:
+        case CSSSelector::Exact:
+            step.value = selector->value().impl();
+            step.valueIsCaseInsensitiveInHTML = htmlAttributeHasCaseInsensitiveValue(selector->attribute());
+            compiled->m_canMatchOffMainThread = false;
+            break;
+        default:
+            return 0;
+        }
+
+        if (selector->hasTag()) {
+            const QualifiedName& tag = selector->tag();
+            if (tag.localName() != starAtom) {
+                step.checksLocalName = true;
+                step.localName = tag.localName().impl();
+            }
+            if (tag.namespaceURI() != starAtom) {
+                step.checksNamespace = true;
+                step.namespaceURI = tag.namespaceURI().impl();
+            }
+        }
+
+        compiled->m_steps.append(step);
+        ++compound.stepCount;
+
+        if (!selector->tagHistory())
+            break;
+        CSSSelector::Relation relation = selector->relation();
+        if (relation == CSSSelector::SubSelector)
+            continue;
+        if (relation != CSSSelector::Descendant && relation != CSSSelector::Child)
+            return 0;
+        compound.relation = relation;
+        compiled->m_compounds.append(compound);
+        compound.firstStep = compiled->m_steps.size();
+        compound.stepCount = 0;
+    }
+    ASSERT(compound.stepCount);
+    compiled->m_compounds.append(compound);
+
+    compiled->m_steps.shrinkToFit();
+    compiled->m_compounds.shrinkToFit();
+    return compiled.release();
+}
+
+inline bool CompiledSelector::matchesCompound(const Compound& compound, Element* element, bool documentIsHTML, RenderStyle* elementStyle, HashSet<AtomicStringImpl*>* selectorAttrs) const
+{
+    const Step* step = m_steps.data() + compound.firstStep;
+    const Step* end = step + compound.stepCount;
+    for (; step < end; ++step) {
+        if (step->checksLocalName && element->localName().impl() != step->localName)
+            return false;
+        if (step->checksNamespace && element->namespaceURI().impl() != step->namespaceURI)
+            return false;
+
+        switch (step->match) {
+        case CSSSelector::None:
+            break;
+        case CSSSelector::Id:
+            if (!element->hasID() || element->idForStyleResolution().impl() != step->value)
+                return false;
+            break;
+        case CSSSelector::Class:
+            if (!element->hasClass() || !static_cast<StyledElement*>(element)->classNames().contains(step->value))
+                return false;
+            break;
+        case CSSSelector::Set:
+        case CSSSelector::Exact: {
+            const QualifiedName& attr = step->selector->attribute();
+            // Same bookkeeping as SelectorChecker::checkOneSelector.
+            if (elementStyle && (!element->isStyledElement() || (!static_cast<StyledElement*>(element)->isMappedAttribute(attr) && attr != typeAttr && attr != readonlyAttr))) {
+                elementStyle->setAffectedByAttributeSelectors();
+                if (selectorAttrs)
+                    selectorAttrs->add(attr.localName().impl());
+            }
+            const AtomicString& value = element->getAttribute(attr);
+            if (value.isNull())
+                return false;
+            if (step->match == CSSSelector::Exact) {
+                if (documentIsHTML && step->valueIsCaseInsensitiveInHTML ? !equalIgnoringCase(step->value, value.impl()) : step->value != value.impl())
+                    return false;
+            }
+            break;
+        }
+        default:
+            ASSERT_NOT_REACHED();
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CompiledSelector::matches(Element* element, bool documentIsHTML, RenderStyle* elementStyle, HashSet<AtomicStringImpl*>* selectorAttrs) const
+{
+    if (!matchesCompound(m_compounds[0], element, documentIsHTML, elementStyle, selectorAttrs))
+        return false;
+
+    // When a child combinator fails we only need to retry the closest
+    // descendant combinator to its right one ancestor further up; retrying
+    // earlier ones cannot produce a match the interpreter would find.
+    size_t backtrackCompound = 0;
+    Element* backtrackElement = 0;
+    for (size_t i = 1; i < m_compounds.size(); ) {
+        if (m_compounds[i - 1].relation == CSSSelector::Descendant) {
+            for (element = element->parentElement(); element; element = element->parentElement()) {
+                if (matchesCompound(m_compounds[i], element, documentIsHTML, 0, 0))
+                    break;
+            }
+            if (!element)
+                return false;
+            backtrackCompound = i;
+            backtrackElement = element;
+            ++i;
+            continue;
+        }
+
+        ASSERT(m_compounds[i - 1].relation == CSSSelector::Child);
+        element = element->parentElement();
+        if (!element)
+            return false;
+        if (matchesCompound(m_compounds[i], element, documentIsHTML, 0, 0)) {
+            ++i;
+            continue;
+        }
+        if (!backtrackCompound)
+            return false;
+        i = backtrackCompound;
+        element = backtrackElement;
+    }
+    return true;
+}
+
 bool CSSStyleSelector::SelectorChecker::checkOneSelector(CSSSelector* sel, Element* e, HashSet<AtomicStringImpl*>* selectorAttrs, PseudoId& dynamicPseudo, bool isSubSelector, bool encounteredLink, RenderStyle* elementStyle, RenderStyle* elementParentStyle) const
 {
     ASSERT(e);
@@ -3046,7 +3484,7 @@ RuleData::RuleData(CSSStyleRule* rule, CSSSelector* selector, unsigned position)
     , m_selector(selector)
     , m_specificity(selector->specificity())
     , m_position(position)
-    , m_hasFastCheckableSelector(isFastCheckableSelector(selector))
+    , m_selectorCompiled(false)
     , m_hasMultipartSelector(selector->tagHistory())
     , m_hasTopSelectorMatchingHTMLBasedOnRuleHash(isSelectorMatchingHTMLBasedOnRuleHash(selector))
 {
@@ -3099,6 +3537,7 @@ inline void RuleData::collectDescendantSelectorIdentifierHashes()
 RuleSet::RuleSet()
     : m_ruleCount(0)
     , m_autoShrinkToFitEnabled(true)
+    , m_selectorsCompiled(true)
 {
 }
 
@@ -3121,10 +3560,56 @@ void RuleSet::addToRuleSet(AtomicStringImpl* key, AtomRuleMap& map,
         map.set(key, rules);
     }
     rules->append(RuleData(rule, sel, m_ruleCount++));
+    m_selectorsCompiled = false;
+}
+
+static inline void addInvalidationFeature(RuleSet::InvalidationFeatureMap& features, AtomicStringImpl* feature, bool affectsOtherElements)
+{
+    pair<RuleSet::InvalidationFeatureMap::iterator, bool> result = features.add(feature, affectsOtherElements);
+    if (!result.second && affectsOtherElements)
+        result.first->second = true;
+}
+
+void RuleSet::collectInvalidationFeatures(const CSSSelector* selector, bool affectsOtherElements)
+{
+    for (; selector; selector = selector->tagHistory()) {
+        switch (selector->m_match) {
+        case CSSSelector::Id:
+            if (!selector->value().isEmpty())
+                addInvalidationFeature(m_idsInSelectors, selector->value().impl(), affectsOtherElements);
+            break;
+        case CSSSelector::Class:
+            if (!selector->value().isEmpty())
+                addInvalidationFeature(m_classesInSelectors, selector->value().impl(), affectsOtherElements);
+            break;
+        case CSSSelector::Exact:
+        case CSSSelector::Set:
+        case CSSSelector::List:
+        case CSSSelector::Hyphen:
+        case CSSSelector::Contain:
+        case CSSSelector::Begin:
+        case CSSSelector::End:
+            addInvalidationFeature(m_attrsInSelectors, selector->attribute().localName().impl(), affectsOtherElements);
+            break;
+        default:
+            break;
+        }
+
+        // Selectors inside :not() and :-webkit-any() apply to the same element as the one containing them.
+        if (CSSSelectorList* selectorList = selector->selectorList()) {
+            for (CSSSelector* subSelector = selectorList->first(); subSelector; subSelector = CSSSelectorList::next(subSelector))
+                collectInvalidationFeatures(subSelector, affectsOtherElements);
+        }
+
+        if (selector->relation() != CSSSelector::SubSelector)
+            affectsOtherElements = true;
+    }
 }
 
 void RuleSet::addRule(CSSStyleRule* rule, CSSSelector* sel)
 {
+    collectInvalidationFeatures(sel, false);
+
     if (sel->m_match == CSSSelector::Id) {
         addToRuleSet(sel->value().impl(), m_idRules, rule, sel);
         return;
@@ -3146,6 +3631,7 @@ void RuleSet::addRule(CSSStyleRule* rule, CSSSelector* sel)
     }
 
     m_universalRules.append(RuleData(rule, sel, m_ruleCount++));
+    m_selectorsCompiled = false;
 }
 
 void RuleSet::addPageRule(CSSStyleRule* rule, CSSSelector* sel)
@@ -3298,6 +3784,32 @@ void RuleSet::shrinkToFit()
     m_pageRules.shrinkToFit();
 }
 
+static inline void compileSelectorsInList(const Vector<RuleData>& rules)
+{
+    size_t size = rules.size();
+    for (size_t i = 0; i < size; ++i)
+        rules[i].compiledSelector();
+}
+
+static inline void compileSelectorsInMap(const RuleSet::AtomRuleMap& map)
+{
+    RuleSet::AtomRuleMap::const_iterator end = map.end();
+    for (RuleSet::AtomRuleMap::const_iterator it = map.begin(); it != end; ++it)
+        compileSelectorsInList(*it->second);
+}
+
+void RuleSet::compileSelectors()
+{
+    if (m_selectorsCompiled)
+        return;
+    // Pseudo-element rules are never matched in parallel.
+    compileSelectorsInMap(m_idRules);
+    compileSelectorsInMap(m_classRules);
+    compileSelectorsInMap(m_tagRules);
+    compileSelectorsInList(m_universalRules);
+    m_selectorsCompiled = true;
+}
+
 // -------------------------------------------------------------------------------------
 // this is mostly boring stuff on how to apply a certain rule to the renderstyle...
 
@@ -3558,6 +4070,8 @@ void CSSStyleSelector::applyProperty(int id, CSSValue *value)
     unsigned short valueType = value->cssValueType();
 
     bool isInherit = m_parentNode && valueType == CSSValue::CSS_INHERIT;
+    if (isInherit)
+        m_appliedInheritValue = true;
     bool isInitial = valueType == CSSValue::CSS_INITIAL || (!m_parentNode && valueType == CSSValue::CSS_INHERIT);
     
     id = CSSProperty::resolveDirectionAwareProperty(id, m_style->direction(), m_style->writingMode());
@@ -7141,6 +7655,86 @@ bool CSSStyleSelector::hasSelectorForAttribute(const AtomicString &attrname) con
     return m_selectorAttrs.contains(attrname.impl());
 }
 
+CSSStyleSelector::InvalidationScope CSSStyleSelector::invalidationScope(InvalidationFeature kind, AtomicStringImpl* feature) const
+{
+    // Include every user agent set that may be in use; being too wide here only costs a restyle.
+    const RuleSet* ruleSets[] = { defaultStyle, defaultQuirksStyle, defaultPrintStyle, defaultViewSourceStyle, m_authorStyle.get(), m_userStyle.get() };
+    InvalidationScope scope = NoInvalidation;
+    for (size_t i = 0; i < WTF_ARRAY_LENGTH(ruleSets); ++i) {
+        if (!ruleSets[i])
+            continue;
+        const RuleSet::InvalidationFeatureMap& features = kind == IdFeature ? ruleSets[i]->m_idsInSelectors
+            : kind == ClassFeature ? ruleSets[i]->m_classesInSelectors : ruleSets[i]->m_attrsInSelectors;
+        RuleSet::InvalidationFeatureMap::const_iterator it = features.find(feature);
+        if (it == features.end())
+            continue;
+        if (it->second)
+            return InvalidateElementAndOthers;
+        scope = InvalidateElement;
+    }
+    return scope;
+}
+
+void CSSStyleSelector::invalidateStyle(Element* element, InvalidationScope scope)
+{
+    if (scope == InvalidateElementAndOthers)
+        element->setNeedsStyleRecalc(FullStyleChange);
+    else if (scope == InvalidateElement)
+        element->setNeedsStyleRecalc(InlineStyleChange);
+}
+
+void CSSStyleSelector::widenInvalidationScopeForClass(const AtomicString& className, InvalidationScope& scope) const
+{
+    InvalidationScope classScope = invalidationScope(ClassFeature, className.impl());
+    if (classScope > scope)
+        scope = classScope;
+}
+
+void CSSStyleSelector::invalidateStyleForClassChange(Element* element, const Vector<AtomicString>& oldClasses, const SpaceSplitString& newClasses)
+{
+    // A class in both lists cannot change which rules match.
+    InvalidationScope scope = NoInvalidation;
+    size_t oldSize = oldClasses.size();
+    for (size_t i = 0; i < oldSize && scope != InvalidateElementAndOthers; ++i) {
+        if (!newClasses.contains(oldClasses[i]))
+            widenInvalidationScopeForClass(oldClasses[i], scope);
+    }
+    size_t newSize = newClasses.size();
+    for (size_t i = 0; i < newSize && scope != InvalidateElementAndOthers; ++i) {
+        if (!oldClasses.contains(newClasses[i]))
+            widenInvalidationScopeForClass(newClasses[i], scope);
+    }
+    invalidateStyle(element, scope);
+}
+
+void CSSStyleSelector::invalidateStyleForIdChange(Element* element, const AtomicString& oldId, const AtomicString& newId)
+{
+    if (oldId == newId)
+        return;
+    InvalidationScope scope = NoInvalidation;
+    if (!oldId.isEmpty())
+        scope = invalidationScope(IdFeature, oldId.impl());
+    if (!newId.isEmpty() && scope != InvalidateElementAndOthers) {
+        InvalidationScope newIdScope = invalidationScope(IdFeature, newId.impl());
+        if (newIdScope > scope)
+            scope = newIdScope;
+    }
+    invalidateStyle(element, scope);
+}
+
+void CSSStyleSelector::invalidateStyleForAttributeChange(Element* element, const AtomicString& localName)
+{
+    InvalidationScope scope = invalidationScope(AttributeFeature, localName.impl());
+    // Attributes used only on the element itself matter if checkOneSelector
+    // recorded them; mapped attributes are restyled through their declarations.
+    if (!m_selectorAttrs.contains(localName.impl())) {
+        if (scope != InvalidateElementAndOthers)
+            return;
+    } else if (scope == NoInvalidation)
+        scope = InvalidateElementAndOthers;
+    invalidateStyle(element, scope);
+}
+
 void CSSStyleSelector::addViewportDependentMediaQueryResult(const MediaQueryExp* expr, bool result)
 {
     m_viewportDependentMediaQueryResults.append(new MediaQueryResult(*expr, result));
@@ -60,9 +60,11 @@ class KeyframeList;
 class KeyframeValue;
 class MediaQueryEvaluator;
 class Node;
+class ParallelMatchBatch;
 class RuleData;
 class RuleSet;
 class Settings;
+class SpaceSplitString;
 class StyleImage;
 class StyleSheet;
 class StyleSheetList;
@@ -97,6 +99,12 @@ public:
         void pushParent(Element* parent);
         void popParent(Element* parent);
 
+        // Called with |parent| pushed when all of its children are about to be
+        // restyled. If enabled, their simple selectors are matched on several
+        // threads up front. A true return must be paired with a call to
+        // finishParallelMatching() once the children are done.
+        bool matchChildrenInParallel(Element* parent);
+        void finishParallelMatching(Element* parent);
 
         PassRefPtr<RenderStyle> styleForElement(Element* e, RenderStyle* parentStyle = 0, bool allowSharing = true, bool resolveForRootDefault = false, bool matchVisitedPseudoClass = false);
         
@@ -165,6 +173,14 @@ public:
         Color getColorFromPrimitiveValue(CSSPrimitiveValue*) const;
 
         bool hasSelectorForAttribute(const AtomicString&) const;
+
+        // Mark an element for style recalc after its classes, id or an
+        // attribute changed, if the current rules can be affected. When the
+        // change only matters to the rightmost compound selector of the rules
+        // using it, only the element itself is restyled.
+        void invalidateStyleForClassChange(Element*, const Vector<AtomicString>& oldClasses, const SpaceSplitString& newClasses);
+        void invalidateStyleForIdChange(Element*, const AtomicString& oldId, const AtomicString& newId);
+        void invalidateStyleForAttributeChange(Element*, const AtomicString& localName);
  
         CSSFontSelector* fontSelector() const { return m_fontSelector.get(); }
 
@@ -212,12 +228,52 @@ public:
         void matchRulesForList(const Vector<RuleData>*, int& firstRuleIndex, int& lastRuleIndex, bool includeEmptyRules);
         bool fastRejectSelector(const RuleData&) const;
         void sortMatchedRules();
+        const Vector<const RuleData*>* parallelMatchedRulesForElement() const;
+
+        enum InvalidationScope { NoInvalidation, InvalidateElement, InvalidateElementAndOthers };
+        enum InvalidationFeature { IdFeature, ClassFeature, AttributeFeature };
+        InvalidationScope invalidationScope(InvalidationFeature, AtomicStringImpl*) const;
+        void widenInvalidationScopeForClass(const AtomicString& className, InvalidationScope&) const;
+        static void invalidateStyle(Element*, InvalidationScope);
         
         bool checkSelector(const RuleData&);
 
         template <bool firstPass>
         void applyDeclarations(bool important, int startIndex, int endIndex);
 
+        // Where the user agent, user and author declarations are in m_matchedDecls.
+        struct MatchedRuleRanges {
+            int firstUARule;
+            int lastUARule;
+            int firstUserRule;
+            int lastUserRule;
+            int firstAuthorRule;
+            int lastAuthorRule;
+
+            bool operator==(const MatchedRuleRanges& other) const
+            {
+                return firstUARule == other.firstUARule && lastUARule == other.lastUARule
+                    && firstUserRule == other.firstUserRule && lastUserRule == other.lastUserRule
+                    && firstAuthorRule == other.firstAuthorRule && lastAuthorRule == other.lastAuthorRule;
+            }
+            bool operator!=(const MatchedRuleRanges& other) const { return !(*this == other); }
+        };
+        void applyMatchedDeclarations(const MatchedRuleRanges&, bool resolveForRootDefault);
+
+        // A style built from an ordered list of matched declarations. It can be
+        // reused for another element with the same list whose parent shares its
+        // inherited data with the parent the style was built against.
+        struct MatchedDeclarationsCacheItem {
+            Vector<RefPtr<CSSMutableStyleDeclaration> > declarations;
+            MatchedRuleRanges ruleRanges;
+            RefPtr<RenderStyle> renderStyle;
+            RefPtr<RenderStyle> parentRenderStyle;
+        };
+        bool canUseMatchedDeclarationsCache(Element*, RenderStyle* visitedStyle, bool resolveForRootDefault, bool matchVisitedPseudoClass) const;
+        unsigned computeMatchedDeclarationsHash() const;
+        const MatchedDeclarationsCacheItem* findFromMatchedDeclarationsCache(unsigned hash, const MatchedRuleRanges&) const;
+        void addToMatchedDeclarationsCache(unsigned hash, const MatchedRuleRanges&);
+
         void matchPageRules(RuleSet*, bool isLeftPage, bool isFirstPage, const String& pageName);
         void matchPageRulesForList(const Vector<RuleData>*, bool isLeftPage, bool isFirstPage, const String& pageName);
         bool isLeftPage(int pageIndex) const;
@@ -242,6 +298,13 @@ public:
         static const unsigned bloomFilterKeyBits = 12;
         OwnPtr<BloomFilter<bloomFilterKeyBits> > m_ancestorIdentifierFilter;
 
+        // One batch per parent whose children were matched by
+        // matchChildrenInParallel(), innermost last.
+        Vector<OwnPtr<ParallelMatchBatch> > m_parallelMatchBatches;
+        // Set while matching the current element against author or user rules
+        // if its simple selectors were already matched in parallel.
+        const Vector<const RuleData*>* m_parallelMatchedRules;
+
         bool m_hasUAAppearance;
         BorderData m_borderData;
         FillLayer m_backgroundData;
@@ -262,7 +325,6 @@ public:
             SelectorMatch checkSelector(CSSSelector*, Element*, HashSet<AtomicStringImpl*>* selectorAttrs, PseudoId& dynamicPseudo, bool isSubSelector, bool encounteredLink, RenderStyle* = 0, RenderStyle* elementParentStyle = 0) const;
             bool checkOneSelector(CSSSelector*, Element*, HashSet<AtomicStringImpl*>* selectorAttrs, PseudoId& dynamicPseudo, bool isSubSelector, bool encounteredLink, RenderStyle*, RenderStyle* elementParentStyle) const;
             bool checkScrollbarPseudoClass(CSSSelector*, PseudoId& dynamicPseudo) const;
-            static bool fastCheckSelector(const CSSSelector*, const Element*);
 
             EInsideLink determineLinkState(Element* element) const;
             EInsideLink determineLinkStateSlowCase(Element* element) const;
@@ -333,6 +395,11 @@ public:
         // merge sorting.
         Vector<const RuleData*, 32> m_matchedRules;
 
+        typedef HashMap<unsigned, MatchedDeclarationsCacheItem> MatchedDeclarationsCache;
+        MatchedDeclarationsCache m_matchedDeclarationsCache;
+        // Set when applying the matched declarations copied a value from the parent.
+        bool m_appliedInheritValue;
+
         RefPtr<CSSRuleList> m_ruleList;
         
         HashSet<int> m_pendingImageProperties; // Hash of CSSPropertyIDs
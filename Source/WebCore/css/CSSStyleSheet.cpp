@@ -21,13 +21,17 @@
 #include "config.h"
 #include "CSSStyleSheet.h"
 
+#include "CSSCharsetRule.h"
 #include "CSSImportRule.h"
+#include "CSSMediaRule.h"
 #include "CSSNamespace.h"
 #include "CSSParser.h"
 #include "CSSRuleList.h"
+#include "CSSStyleRule.h"
 #include "Document.h"
 #include "ExceptionCode.h"
 #include "HTMLNames.h"
+#include "MediaList.h"
 #include "Node.h"
 #include "SVGNames.h"
 #include "SecurityOrigin.h"
@@ -83,8 +87,26 @@ CSSStyleSheet::CSSStyleSheet(CSSRule* ownerRule, const String& href, const KURL&
     m_isUserStyleSheet = parentSheet ? parentSheet->isUserStyleSheet() : false;
 }
 
+// A rule that outlives its style sheet can no longer resolve the URLs in a
+// deferred declaration block against it, so parse those while we still can.
+static void parseDeferredDeclarationsOfRetainedRules(StyleBase* item, bool parentIsRetained)
+{
+    bool isRetained = parentIsRetained || !item->hasOneRef();
+    if (item->isStyleRule()) {
+        CSSStyleRule* rule = static_cast<CSSStyleRule*>(item);
+        if (isRetained && rule->hasDeferredDeclaration())
+            rule->parseDeferredDeclaration();
+    } else if (item->isMediaRule()) {
+        CSSRuleList* rules = static_cast<CSSMediaRule*>(item)->cssRules();
+        for (unsigned i = 0; i < rules->length(); ++i)
+            parseDeferredDeclarationsOfRetainedRules(rules->item(i), isRetained);
+    }
+}
+
 CSSStyleSheet::~CSSStyleSheet()
 {
+    for (unsigned i = 0; i < length(); ++i)
+        parseDeferredDeclarationsOfRetainedRules(item(i), false);
 }
 
 CSSRule *CSSStyleSheet::ownerRule() const
@@ -205,6 +227,69 @@ bool CSSStyleSheet::parseStringAtLine(const String& string, bool strict, int sta
     return true;
 }
 
+void CSSStyleSheet::parseStringWithDeferredRuleBodies(const String& string, bool strict)
+{
+    setStrictParsing(strict);
+    CSSParser p(strict);
+    p.setDeferAllRuleBodies(true);
+    p.parseSheet(this, string);
+}
+
+// Rules that load resources or declare things for the whole sheet are left
+// to a per-document parse.
+static bool canShareRule(StyleBase* item)
+{
+    if (item->isCharsetRule())
+        return true;
+    if (item->isStyleRule())
+        return static_cast<CSSStyleRule*>(item)->hasDeferredDeclaration();
+    if (item->isMediaRule()) {
+        CSSRuleList* rules = static_cast<CSSMediaRule*>(item)->cssRules();
+        for (unsigned i = 0; i < rules->length(); ++i) {
+            if (!canShareRule(rules->item(i)))
+                return false;
+        }
+        return true;
+    }
+    return false;
+}
+
+bool CSSStyleSheet::canShareContents()
+{
+    if (m_namespaces)
+        return false;
+    for (unsigned i = 0; i < length(); ++i) {
+        if (!canShareRule(item(i)))
+            return false;
+    }
+    return true;
+}
+
+static PassRefPtr<CSSRule> copyRule(CSSStyleSheet* sheet, StyleBase* item)
+{
+    if (item->isCharsetRule())
+        return CSSCharsetRule::create(sheet, static_cast<CSSCharsetRule*>(item)->encoding());
+    if (item->isStyleRule())
+        return static_cast<CSSStyleRule*>(item)->copy(sheet);
+    ASSERT(item->isMediaRule());
+    CSSMediaRule* mediaRule = static_cast<CSSMediaRule*>(item);
+    CSSRuleList* rules = mediaRule->cssRules();
+    RefPtr<CSSRuleList> rulesCopy = CSSRuleList::create();
+    for (unsigned i = 0; i < rules->length(); ++i)
+        rulesCopy->append(copyRule(sheet, rules->item(i)).get());
+    return CSSMediaRule::create(sheet, MediaList::create(mediaRule->media()->mediaText(), false), rulesCopy.release());
+}
+
+void CSSStyleSheet::copyContentsFrom(CSSStyleSheet* other)
+{
+    ASSERT(!length());
+    ASSERT(other->canShareContents());
+    m_strictParsing = other->m_strictParsing;
+    m_hasSyntacticallyValidCSSHeader = other->m_hasSyntacticallyValidCSSHeader;
+    for (unsigned i = 0; i < other->length(); ++i)
+        append(copyRule(this, other->item(i)));
+}
+
 bool CSSStyleSheet::isLoading()
 {
     unsigned len = length();
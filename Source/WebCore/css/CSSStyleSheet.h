@@ -83,6 +83,15 @@ public:
 
     bool parseStringAtLine(const String&, bool strict, int startLineNumber);
 
+    // Parses only the selectors up front and leaves every declaration block
+    // as source text until its rule is used. Such contents can be shared by
+    // documents that load the same resource: a copy is selectors and text
+    // ranges only, and each document parses the declarations it uses
+    // against its own sheet.
+    void parseStringWithDeferredRuleBodies(const String&, bool strict);
+    bool canShareContents();
+    void copyContentsFrom(CSSStyleSheet*);
+
     virtual bool isLoading();
 
     virtual void checkLoaded();
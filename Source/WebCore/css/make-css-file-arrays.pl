@@ -50,11 +50,17 @@ for my $in (@ARGV) {
 
     # Crunch whitespace just to make it a little smaller.
     # Could do work to avoid doing this inside quote marks but our files don't have runs of spaces in quotes.
-    # Could crunch further based on places where whitespace is optional.
     $text =~ s|\s+| |gs;
     $text =~ s|^ ||;
     $text =~ s| $||;
 
+    # The style sheets are parsed on first use in every process, so also drop
+    # whitespace where it is optional. Our files don't have these characters
+    # in quotes. Whitespace around ':' is left alone since it is significant
+    # in selectors.
+    $text =~ s| ?([{};,]) ?|$1|g;
+    $text =~ s|;}|}|g;
+
     # Write out a C array of the characters.
     my $length = length $text;
     print HEADER "extern const char ${name}UserAgentStyleSheet[${length}];\n";
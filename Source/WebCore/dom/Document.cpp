@@ -98,6 +98,7 @@
 #include "ImageLoader.h"
 #include "InspectorInstrumentation.h"
 #include "KeyboardEvent.h"
+#include "LayoutStatistics.h"
 #include "Logging.h"
 #include "MediaQueryList.h"
 #include "MediaQueryMatcher.h"
@@ -136,6 +137,7 @@
 #include "SelectionController.h"
 #include "Settings.h"
 #include "StaticHashSetNodeList.h"
+#include "StyleDataInterner.h"
 #include "StyleSheetList.h"
 #include "TextEvent.h"
 #include "TextResourceDecoder.h"
@@ -582,6 +584,10 @@ Document::~Document()
 
     if (m_implementation)
         m_implementation->ownerDocumentDestroyed();
+
+    // The styles of the removed elements may have been the last users of
+    // some shared style data.
+    StyleDataInterner::purge();
 }
 
 void Document::removedLastRef()
@@ -1472,6 +1478,7 @@ void Document::recalcStyle(StyleChange change)
 
     m_inStyleRecalc = true;
     suspendPostAttachCallbacks();
+    LayoutStatistics::TriggerScope layoutTriggerScope(LayoutStatistics::StyleChangeTrigger);
     RenderWidget::suspendWidgetHierarchyUpdates();
     
     RefPtr<FrameView> frameView = view();
@@ -1628,6 +1635,33 @@ void Document::updateLayoutIgnorePendingStylesheets()
     m_ignorePendingStylesheets = oldIgnore;
 }
 
+void Document::updateLayoutIgnorePendingStylesheetsForWidth(Element* element)
+{
+    // A subframe's width depends on the layout of its owner's document.
+    if (!haveStylesheetsLoaded() || ownerElement()) {
+        updateLayoutIgnorePendingStylesheets();
+        return;
+    }
+
+    updateStyleIfNeeded();
+
+    // Scripts that alternate style changes with width reads would otherwise
+    // lay out the whole frame on every read. Only the box's own style and the
+    // widths of its containing blocks matter here, so if none of those are
+    // dirty the rest of the tree can wait for the scheduled layout. A view
+    // whose scrollbar comes and goes with the content height can narrow
+    // every box, though.
+    FrameView* frameView = view();
+    RenderObject* renderer = element->renderer();
+    if (frameView && !frameView->isInLayout() && renderer && renderer->isBox()
+        && renderer->style()->isHorizontalWritingMode()
+        && (frameView->platformWidget() || frameView->verticalScrollbarMode() != ScrollbarAuto)
+        && toRenderBox(renderer)->logicalWidthIsUpToDate())
+        return;
+
+    updateLayout();
+}
+
 PassRefPtr<RenderStyle> Document::styleForElementIgnoringPendingStylesheets(Element* element)
 {
     ASSERT_ARG(element, element->document() == this);
@@ -1783,8 +1817,11 @@ void Document::detach()
 
     unscheduleStyleRecalc();
 
-    if (render)
+    if (render) {
         render->destroy();
+        // Drop the shared style data only the destroyed renderers used.
+        StyleDataInterner::purge();
+    }
     
     // This is required, as our Frame might delete itself as soon as it detaches
     // us. However, this violates Node::detach() semantics, as it's never
@@ -525,6 +525,9 @@ public:
     virtual void updateStyleIfNeeded();
     void updateLayout();
     void updateLayoutIgnorePendingStylesheets();
+    // Like updateLayoutIgnorePendingStylesheets(), but skips the layout when
+    // it would not change the width of the given element's box.
+    void updateLayoutIgnorePendingStylesheetsForWidth(Element*);
     PassRefPtr<RenderStyle> styleForElementIgnoringPendingStylesheets(Element*);
     PassRefPtr<RenderStyle> styleForPage(int pageIndex);
 
@@ -373,7 +373,7 @@ int Element::offsetTop()
 
 int Element::offsetWidth()
 {
-    document()->updateLayoutIgnorePendingStylesheets();
+    document()->updateLayoutIgnorePendingStylesheetsForWidth(this);
     if (RenderBoxModelObject* rend = renderBoxModelObject())
         return adjustForAbsoluteZoom(rend->offsetWidth(), rend);
     return 0;
@@ -416,7 +416,7 @@ int Element::clientTop()
 
 int Element::clientWidth()
 {
-    document()->updateLayoutIgnorePendingStylesheets();
+    document()->updateLayoutIgnorePendingStylesheetsForWidth(this);
 
     // When in strict mode, clientWidth for the document element should return the width of the containing frame.
     // When in quirks mode, clientWidth for the body element should return the width of the containing frame.
@@ -767,12 +767,19 @@ void Element::updateAfterAttributeChanged(Attribute* attr)
     
 void Element::recalcStyleIfNeededAfterAttributeChanged(Attribute* attr)
 {
-    if (document()->attached() && document()->styleSelector()->hasSelectorForAttribute(attr->name().localName()))
-        setNeedsStyleRecalc();
+    if (!document()->attached())
+        return;
+    if (!attached()) {
+        if (document()->styleSelector()->hasSelectorForAttribute(attr->name().localName()))
+            setNeedsStyleRecalc();
+        return;
+    }
+    document()->styleSelector()->invalidateStyleForAttributeChange(this, attr->name().localName());
 }
 
 void Element::idAttributeChanged(Attribute* attr)
 {
+    AtomicString oldId = hasID() && attributeMap() ? attributeMap()->idForStyleResolution() : nullAtom;
     setHasID(!attr->isNull());
     if (attributeMap()) {
         if (attr->isNull())
@@ -782,7 +789,10 @@ void Element::idAttributeChanged(Attribute* attr)
         else
             attributeMap()->setIdForStyleResolution(attr->value());
     }
-    setNeedsStyleRecalc();
+    if (attached() && document()->attached())
+        document()->styleSelector()->invalidateStyleForIdChange(this, oldId, hasID() && attributeMap() ? attributeMap()->idForStyleResolution() : nullAtom);
+    else
+        setNeedsStyleRecalc();
 }
     
 // Returns true is the given attribute is an event handler.
@@ -1158,6 +1168,12 @@ void Element::recalcStyle(StyleChange change)
         }
     }
     StyleSelectorParentPusher parentPusher(this);
+    CSSStyleSelector* styleSelector = 0;
+    if (change >= Force && renderStyle() && firstChild()) {
+        parentPusher.push();
+        if (document()->styleSelector()->matchChildrenInParallel(this))
+            styleSelector = document()->styleSelector();
+    }
     // FIXME: This check is good enough for :hover + foo, but it is not good enough for :hover + foo + bar.
     // For now we will just worry about the common case, since it's a lot trickier to get the second case right
     // without doing way too much re-resolution.
@@ -1180,6 +1196,8 @@ void Element::recalcStyle(StyleChange change)
             shadow->recalcStyle(change);
         }
     }
+    if (styleSelector && styleSelector == document()->styleSelector())
+        styleSelector->finishParallelMatching(this);
 
     clearNeedsStyleRecalc();
     clearChildNeedsStyleRecalc();
@@ -212,6 +212,16 @@ bool StyledElement::mapToEntry(const QualifiedName& attrName, MappedAttributeEnt
 
 void StyledElement::classAttributeChanged(const AtomicString& newClassString)
 {
+    // The class names are owned by the attribute map and replaced below.
+    Vector<AtomicString> oldClassNames;
+    if (attributeMap()) {
+        const SpaceSplitString& classNames = attributeMap()->classNames();
+        size_t size = classNames.size();
+        oldClassNames.reserveInitialCapacity(size);
+        for (size_t i = 0; i < size; ++i)
+            oldClassNames.uncheckedAppend(classNames[i]);
+    }
+
     const UChar* characters = newClassString.characters();
     unsigned length = newClassString.length();
     unsigned i;
@@ -227,7 +237,11 @@ void StyledElement::classAttributeChanged(const AtomicString& newClassString)
             static_cast<ClassList*>(classList)->reset(newClassString);
     } else if (attributeMap())
         attributeMap()->clearClass();
-    setNeedsStyleRecalc();
+    if (attached() && document()->attached()) {
+        DEFINE_STATIC_LOCAL(SpaceSplitString, noClassNames, ());
+        document()->styleSelector()->invalidateStyleForClassChange(this, oldClassNames, attributeMap() ? attributeMap()->classNames() : noClassNames);
+    } else
+        setNeedsStyleRecalc();
     dispatchSubtreeModifiedEvent();
 }
 
@@ -386,7 +386,16 @@ void HTMLLinkElement::setCSSStyleSheet(const String& href, const KURL& baseURL,
 #endif
 
     String sheetText = sheet->sheetText(enforceMIMEType, &validMIMEType);
-    m_sheet->parseString(sheetText, strictParsing);
+    if (CSSStyleSheet* sharedSheet = sheet->sharedParsedSheet(strictParsing, enforceMIMEType, document()->isHTMLDocument()))
+        m_sheet->copyContentsFrom(sharedSheet);
+    else {
+        m_sheet->parseStringWithDeferredRuleBodies(sheetText, strictParsing);
+        if (m_sheet->canShareContents()) {
+            RefPtr<CSSStyleSheet> contents = CSSStyleSheet::create();
+            contents->copyContentsFrom(m_sheet.get());
+            sheet->setSharedParsedSheet(contents.release(), strictParsing, enforceMIMEType, document()->isHTMLDocument(), sheetText.length());
+        }
+    }
 
     // If we're loading a stylesheet cross-origin, and the MIME type is not
     // standard, require the CSS to at least start with a syntactically
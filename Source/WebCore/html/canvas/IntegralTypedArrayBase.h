@@ -43,11 +43,8 @@ class IntegralTypedArrayBase : public TypedArrayBase<T> {
     {
         if (index >= TypedArrayBase<T>::m_length)
             return;
-        if (isnan(value)) // Clamp NaN to 0
-            value = 0;
-        // The double cast is necessary to get the correct wrapping
-        // for out-of-range values with Int32Array and Uint32Array.
-        TypedArrayBase<T>::data()[index] = static_cast<T>(static_cast<int64_t>(value));
+        // Shared with the JIT's typed array put fast path so both store the same value.
+        TypedArrayBase<T>::data()[index] = doubleToTypedArrayInteger<T>(value);
     }
 
     // Invoked by the indexed getter. Does not perform range checks; caller
@@ -49,11 +49,7 @@ void Uint8ClampedArray::set(unsigned index, double value)
 {
     if (index >= m_length)
         return;
-    if (isnan(value) || value < 0)
-        value = 0;
-    else if (value > 255)
-        value = 255;
-    data()[index] = static_cast<unsigned char>(value + 0.5);
+    data()[index] = doubleToClampedByte(value);
 }
 
 Uint8ClampedArray::Uint8ClampedArray(PassRefPtr<ArrayBuffer> buffer, unsigned byteOffset, unsigned length)
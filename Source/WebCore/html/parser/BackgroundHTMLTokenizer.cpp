@@ -0,0 +1,325 @@
+/*
+ * Copyright 2011, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "BackgroundHTMLTokenizer.h"
+
+#include "HTMLNames.h"
+#include "MathMLNames.h"
+#include "SVGNames.h"
+#include <wtf/MainThread.h>
+
+namespace WebCore {
+
+using namespace HTMLNames;
+
+// Tokens are handed to the main thread in batches to amortize the locking
+// and the main thread notification.
+static const unsigned tokensPerBatch = 64;
+
+// HTMLToken carries large inline buffers, so bound how far the background
+// thread may run ahead of tree construction.
+static const unsigned maxOutstandingTokens = 512;
+
+namespace {
+
+// Only reads the characters of the global tag name, which is safe to do
+// off the main thread.
+bool tagNameIs(const HTMLToken& token, const QualifiedName& tagName)
+{
+    const HTMLToken::DataVector& name = token.name();
+    const AtomicString& localName = tagName.localName();
+    if (name.size() != localName.length())
+        return false;
+    return !memcmp(name.data(), localName.characters(), name.size() * sizeof(UChar));
+}
+
+} // namespace
+
+PassRefPtr<BackgroundHTMLTokenizer> BackgroundHTMLTokenizer::create(BackgroundHTMLTokenizerClient* client, bool usePreHTML5ParserQuirks, bool scriptingEnabled, bool pluginsEnabled)
+{
+    return adoptRef(new BackgroundHTMLTokenizer(client, usePreHTML5ParserQuirks, scriptingEnabled, pluginsEnabled));
+}
+
+BackgroundHTMLTokenizer::BackgroundHTMLTokenizer(BackgroundHTMLTokenizerClient* client, bool usePreHTML5ParserQuirks, bool scriptingEnabled, bool pluginsEnabled)
+    : m_client(client)
+    , m_thread(0)
+    , m_pendingEndOfFile(false)
+    , m_stopped(false)
+    , m_notificationPending(false)
+    , m_outstandingTokenCount(0)
+    , m_tokenizer(HTMLTokenizer::create(usePreHTML5ParserQuirks))
+    , m_appendedLength(0)
+    , m_consumedLength(0)
+    , m_scriptingEnabled(scriptingEnabled)
+    , m_pluginsEnabled(pluginsEnabled)
+    , m_inTextMode(false)
+    , m_foreignContentDepth(0)
+{
+}
+
+BackgroundHTMLTokenizer::~BackgroundHTMLTokenizer()
+{
+}
+
+bool BackgroundHTMLTokenizer::start(const HTMLTokenizer::Checkpoint& checkpoint)
+{
+    ASSERT(isMainThread());
+    ASSERT(!m_thread);
+    m_tokenizer->restoreCheckpoint(checkpoint);
+
+    // The background thread keeps itself alive until it notices stop().
+    ref();
+    m_thread = createThread(tokenizerThreadStart, this, "WebCore: HTML tokenizer");
+    if (!m_thread) {
+        deref();
+        return false;
+    }
+    detachThread(m_thread);
+    return true;
+}
+
+void BackgroundHTMLTokenizer::append(const String& source)
+{
+    ASSERT(isMainThread());
+    MutexLocker locker(m_mutex);
+    m_pendingInput.append(source.crossThreadString());
+    m_condition.signal();
+}
+
+void BackgroundHTMLTokenizer::finish()
+{
+    ASSERT(isMainThread());
+    MutexLocker locker(m_mutex);
+    m_pendingEndOfFile = true;
+    m_condition.signal();
+}
+
+void BackgroundHTMLTokenizer::stop()
+{
+    ASSERT(isMainThread());
+    m_client = 0;
+    MutexLocker locker(m_mutex);
+    m_stopped = true;
+    m_pendingInput.clear();
+    m_pendingTokens.clear();
+    m_condition.signal();
+}
+
+void BackgroundHTMLTokenizer::takeTokens(SpeculativeHTMLTokenVector& tokens)
+{
+    ASSERT(isMainThread());
+    ASSERT(tokens.isEmpty());
+    MutexLocker locker(m_mutex);
+    m_pendingTokens.swap(tokens);
+    m_notificationPending = false;
+}
+
+void BackgroundHTMLTokenizer::didConsumeTokens(unsigned count)
+{
+    ASSERT(isMainThread());
+    MutexLocker locker(m_mutex);
+    ASSERT(m_outstandingTokenCount >= count);
+    m_outstandingTokenCount -= count;
+    m_condition.signal();
+}
+
+void* BackgroundHTMLTokenizer::tokenizerThreadStart(void* context)
+{
+    BackgroundHTMLTokenizer* tokenizer = static_cast<BackgroundHTMLTokenizer*>(context);
+    tokenizer->run();
+    tokenizer->deref();
+    return 0;
+}
+
+void BackgroundHTMLTokenizer::notifyClientOnMainThread(void* context)
+{
+    RefPtr<BackgroundHTMLTokenizer> tokenizer = adoptRef(static_cast<BackgroundHTMLTokenizer*>(context));
+    if (tokenizer->m_client)
+        tokenizer->m_client->didReceiveSpeculativeTokens();
+}
+
+void BackgroundHTMLTokenizer::run()
+{
+    ASSERT(!isMainThread());
+    while (waitForInput()) {
+        if (!tokenizeAvailableInput())
+            break;
+    }
+
+    // Release the input and any partial token on this thread.
+    m_source.clear();
+    m_token.clear();
+    m_tokens.clear();
+}
+
+bool BackgroundHTMLTokenizer::waitForInput()
+{
+    MutexLocker locker(m_mutex);
+    while (!m_stopped && m_pendingInput.isEmpty() && !m_pendingEndOfFile)
+        m_condition.wait(m_mutex);
+    if (m_stopped)
+        return false;
+
+    for (size_t i = 0; i < m_pendingInput.size(); ++i) {
+        m_appendedLength += m_pendingInput[i].length();
+        m_source.append(SegmentedString(m_pendingInput[i]));
+    }
+    m_pendingInput.clear();
+
+    if (m_pendingEndOfFile) {
+        // Matches HTMLInputStream::markEndOfFile.
+        static const UChar endOfFileMarker = 0;
+        m_appendedLength += 1;
+        m_source.append(SegmentedString(String(&endOfFileMarker, 1)));
+        m_source.close();
+        m_pendingEndOfFile = false;
+    }
+    return true;
+}
+
+// Returns false once there is nothing more to do on this thread, either
+// because we were stopped or because we emitted the end of file.
+bool BackgroundHTMLTokenizer::tokenizeAvailableInput()
+{
+    while (true) {
+        // m_token might hold a token left incomplete by the previous chunk.
+        if (!m_token)
+            m_token = adoptPtr(new SpeculativeHTMLToken);
+        HTMLToken& token = m_token->token;
+
+        // Record the token's range the way HTMLSourceTracker does, so the
+        // XSS filter can still recover the source of a speculative token.
+        if (token.type() == HTMLToken::Uninitialized)
+            token.setBaseOffset(m_source.numberOfCharactersConsumed());
+        if (!m_tokenizer->nextToken(m_source, token))
+            break;
+        token.end(m_source.numberOfCharactersConsumed());
+
+        // SegmentedString::length() still counts characters the entity
+        // parser pushed back, so this stays an exact stream offset.
+        unsigned consumedLength = m_appendedLength - m_source.length();
+        m_token->sourceLength = consumedLength - m_consumedLength;
+        m_consumedLength = consumedLength;
+
+        m_tokenizer->saveCheckpoint(m_token->checkpoint);
+        simulateTreeBuilder(token);
+        m_token->speculatedState = m_tokenizer->state();
+        m_token->speculatedSkipLeadingNewLineForListing = m_tokenizer->skipLeadingNewLineForListing();
+        m_token->speculatedForceNullCharacterReplacement = m_tokenizer->forceNullCharacterReplacement();
+        m_token->speculatedShouldAllowCDATA = m_tokenizer->shouldAllowCDATA();
+
+        bool isEndOfFile = token.type() == HTMLToken::EndOfFile;
+        m_tokens.append(m_token.release());
+        if (isEndOfFile) {
+            flushTokens();
+            return false;
+        }
+        if (m_tokens.size() >= tokensPerBatch && !flushTokens())
+            return false;
+    }
+    return flushTokens();
+}
+
+bool BackgroundHTMLTokenizer::flushTokens()
+{
+    if (m_tokens.isEmpty())
+        return true;
+
+    bool shouldNotify;
+    {
+        MutexLocker locker(m_mutex);
+        while (!m_stopped && m_outstandingTokenCount >= maxOutstandingTokens)
+            m_condition.wait(m_mutex);
+        if (m_stopped)
+            return false;
+
+        m_outstandingTokenCount += m_tokens.size();
+        if (m_pendingTokens.isEmpty())
+            m_pendingTokens.swap(m_tokens);
+        else {
+            for (size_t i = 0; i < m_tokens.size(); ++i)
+                m_pendingTokens.append(m_tokens[i].release());
+            m_tokens.clear();
+        }
+        shouldNotify = !m_notificationPending;
+        m_notificationPending = true;
+    }
+
+    if (shouldNotify) {
+        ref();
+        callOnMainThread(notifyClientOnMainThread, this);
+    }
+    return true;
+}
+
+// Mirrors the calls HTMLTreeBuilder makes on m_parser->tokenizer() for
+// well-formed content. Anything this gets wrong (for example <textarea>
+// inside <select>, or HTML content inside <foreignObject>) is caught by
+// the main thread when it compares the real tokenizer state.
+void BackgroundHTMLTokenizer::simulateTreeBuilder(const HTMLToken& token)
+{
+    if (token.type() == HTMLToken::StartTag) {
+        if (m_foreignContentDepth) {
+            if (!token.selfClosing())
+                ++m_foreignContentDepth;
+        } else if (tagNameIs(token, SVGNames::svgTag) || tagNameIs(token, MathMLNames::mathTag)) {
+            if (!token.selfClosing())
+                m_foreignContentDepth = 1;
+        } else if (tagNameIs(token, textareaTag)) {
+            m_tokenizer->setSkipLeadingNewLineForListing(true);
+            m_tokenizer->setState(HTMLTokenizer::RCDATAState);
+            m_inTextMode = true;
+        } else if (tagNameIs(token, titleTag)) {
+            m_tokenizer->setState(HTMLTokenizer::RCDATAState);
+            m_inTextMode = true;
+        } else if (tagNameIs(token, plaintextTag))
+            m_tokenizer->setState(HTMLTokenizer::PLAINTEXTState);
+        else if (tagNameIs(token, scriptTag)) {
+            m_tokenizer->setState(HTMLTokenizer::ScriptDataState);
+            m_inTextMode = true;
+        } else if (tagNameIs(token, styleTag)
+            || tagNameIs(token, iframeTag)
+            || tagNameIs(token, xmpTag)
+            || (tagNameIs(token, noembedTag) && m_pluginsEnabled)
+            || tagNameIs(token, noframesTag)
+            || (tagNameIs(token, noscriptTag) && m_scriptingEnabled)) {
+            m_tokenizer->setState(HTMLTokenizer::RAWTEXTState);
+            m_inTextMode = true;
+        } else if (tagNameIs(token, preTag) || tagNameIs(token, listingTag))
+            m_tokenizer->setSkipLeadingNewLineForListing(true);
+    } else if (token.type() == HTMLToken::EndTag) {
+        if (m_inTextMode) {
+            m_inTextMode = false;
+            m_tokenizer->setState(HTMLTokenizer::DataState);
+        } else if (m_foreignContentDepth)
+            --m_foreignContentDepth;
+    }
+
+    m_tokenizer->setForceNullCharacterReplacement(m_inTextMode || m_foreignContentDepth);
+    m_tokenizer->setShouldAllowCDATA(m_foreignContentDepth);
+}
+
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright 2011, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BackgroundHTMLTokenizer_h
+#define BackgroundHTMLTokenizer_h
+
+#include "HTMLToken.h"
+#include "HTMLTokenizer.h"
+#include "SegmentedString.h"
+#include <wtf/OwnPtr.h>
+#include <wtf/PassRefPtr.h>
+#include <wtf/Threading.h>
+#include <wtf/ThreadSafeRefCounted.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+// A token produced on the background thread, together with what the main
+// thread needs to check the speculation and to take over tokenizing.
+class SpeculativeHTMLToken {
+    WTF_MAKE_NONCOPYABLE(SpeculativeHTMLToken); WTF_MAKE_FAST_ALLOCATED;
+public:
+    SpeculativeHTMLToken() : sourceLength(0) { }
+
+    HTMLToken token;
+
+    // The number of input characters consumed between the end of the
+    // previous token and the end of this one.
+    unsigned sourceLength;
+
+    // The tokenizer right after it emitted this token, before the simulated
+    // tree builder adjusted it.
+    HTMLTokenizer::Checkpoint checkpoint;
+
+    // The adjustments the background thread assumed the tree builder would
+    // make in response to this token. If the real tree builder disagrees,
+    // the tokens that follow were produced in the wrong state.
+    HTMLTokenizer::State speculatedState;
+    bool speculatedSkipLeadingNewLineForListing;
+    bool speculatedForceNullCharacterReplacement;
+    bool speculatedShouldAllowCDATA;
+};
+
+typedef Vector<OwnPtr<SpeculativeHTMLToken> > SpeculativeHTMLTokenVector;
+
+class BackgroundHTMLTokenizerClient {
+public:
+    virtual ~BackgroundHTMLTokenizerClient() { }
+
+    // Called on the main thread when takeTokens() has something to return.
+    virtual void didReceiveSpeculativeTokens() = 0;
+};
+
+// Tokenizes network-sourced HTML on a separate thread. The main thread
+// still owns the authoritative input stream; it forwards a copy of every
+// chunk here and consumes the resulting tokens in order. Only one side
+// runs HTMLTreeBuilder, so this thread approximates the tree builder's
+// effect on the tokenizer state and the main thread validates each guess.
+class BackgroundHTMLTokenizer : public ThreadSafeRefCounted<BackgroundHTMLTokenizer> {
+public:
+    static PassRefPtr<BackgroundHTMLTokenizer> create(BackgroundHTMLTokenizerClient*, bool usePreHTML5ParserQuirks, bool scriptingEnabled, bool pluginsEnabled);
+    ~BackgroundHTMLTokenizer();
+
+    // The following are called on the main thread.
+    // Returns false if the thread could not be started.
+    bool start(const HTMLTokenizer::Checkpoint&);
+    void append(const String&);
+    void finish();
+    void stop();
+
+    void takeTokens(SpeculativeHTMLTokenVector&);
+    void didConsumeTokens(unsigned count);
+
+private:
+    BackgroundHTMLTokenizer(BackgroundHTMLTokenizerClient*, bool usePreHTML5ParserQuirks, bool scriptingEnabled, bool pluginsEnabled);
+
+    static void* tokenizerThreadStart(void*);
+    static void notifyClientOnMainThread(void*);
+
+    // The following are called on the background thread.
+    void run();
+    bool waitForInput();
+    bool tokenizeAvailableInput();
+    bool flushTokens();
+    void simulateTreeBuilder(const HTMLToken&);
+
+    BackgroundHTMLTokenizerClient* m_client;
+    ThreadIdentifier m_thread;
+
+    // Guards everything up to m_pendingTokens.
+    Mutex m_mutex;
+    ThreadCondition m_condition;
+    Vector<String> m_pendingInput;
+    bool m_pendingEndOfFile;
+    bool m_stopped;
+    bool m_notificationPending;
+    unsigned m_outstandingTokenCount;
+    SpeculativeHTMLTokenVector m_pendingTokens;
+
+    // Owned by the background thread once it has started.
+    OwnPtr<HTMLTokenizer> m_tokenizer;
+    SegmentedString m_source;
+    unsigned m_appendedLength;
+    unsigned m_consumedLength;
+    OwnPtr<SpeculativeHTMLToken> m_token;
+    SpeculativeHTMLTokenVector m_tokens;
+
+    // Simulated tree builder state.
+    bool m_scriptingEnabled;
+    bool m_pluginsEnabled;
+    bool m_inTextMode;
+    unsigned m_foreignContentDepth;
+};
+
+}
+
+#endif
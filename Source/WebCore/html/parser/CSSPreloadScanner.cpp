@@ -33,11 +33,13 @@
 #include "Document.h"
 #include "HTMLParserIdioms.h"
 #include "HTMLToken.h"
+#include <wtf/ASCIICType.h>
 
 namespace WebCore {
 
 CSSPreloadScanner::CSSPreloadScanner(Document* document)
     : m_state(Initial)
+    , m_scanningBody(false)
     , m_document(document)
 {
 }
@@ -54,7 +56,22 @@ void CSSPreloadScanner::scan(const HTMLToken& token, bool scanningBody)
     m_scanningBody = scanningBody;
 
     const HTMLToken::DataVector& characters = token.characters();
-    for (HTMLToken::DataVector::const_iterator iter = characters.begin(); iter != characters.end() && m_state != DoneParsingImportRules; ++iter)
+    scan(characters.data(), characters.data() + characters.size());
+}
+
+void CSSPreloadScanner::scan(const String& sheetText, const KURL& baseURL)
+{
+    // Style sheets are only ever fetched on behalf of the body or the head,
+    // and both are treated the same once the load is under way.
+    m_scanningBody = true;
+    m_baseURL = baseURL;
+    scan(sheetText.characters(), sheetText.characters() + sheetText.length());
+    m_baseURL = KURL();
+}
+
+void CSSPreloadScanner::scan(const UChar* begin, const UChar* end)
+{
+    for (const UChar* iter = begin; iter != end && m_state != DoneParsingImportRules; ++iter)
         tokenize(*iter);
 }
 
@@ -190,12 +207,81 @@ static String parseCSSStringOrURL(const UChar* characters, size_t length)
     return String(characters + offset, reducedLength);
 }
 
+static inline bool isCSSURLStart(const UChar* characters)
+{
+    return (characters[0] == 'u' || characters[0] == 'U')
+        && (characters[1] == 'r' || characters[1] == 'R')
+        && (characters[2] == 'l' || characters[2] == 'L')
+        && characters[3] == '(';
+}
+
+// Characters that can continue a CSS identifier, so that "url(" right after
+// one is part of another function name, as in "myurl(".
+static inline bool isCSSIdentifierCharacter(UChar c)
+{
+    return isASCIIAlphanumeric(c) || c == '-' || c == '_' || c == '\\' || c >= 0x80;
+}
+
+void CSSPreloadScanner::collectURLsInDeclarations(const String& declarations, Vector<String>& urls)
+{
+    const UChar* characters = declarations.characters();
+    size_t length = declarations.length();
+    if (length < 5)
+        return;
+
+    size_t position = 0;
+    while (position + 5 <= length) {
+        if (!isCSSURLStart(characters + position) || (position && isCSSIdentifierCharacter(characters[position - 1]))) {
+            ++position;
+            continue;
+        }
+        size_t start = position + 4;
+        size_t end = start;
+        UChar quote = 0;
+        while (end < length && isHTMLSpace(characters[end]))
+            ++end;
+        if (end < length && (characters[end] == '"' || characters[end] == '\'')) {
+            quote = characters[end++];
+            while (end < length && characters[end] != quote)
+                ++end;
+            if (end < length)
+                ++end;
+        }
+        while (end < length && characters[end] != ')')
+            ++end;
+        if (end == length)
+            return;
+
+        size_t valueStart = start;
+        size_t valueEnd = end;
+        while (valueStart < valueEnd && isHTMLSpace(characters[valueStart]))
+            ++valueStart;
+        while (valueEnd > valueStart && isHTMLSpace(characters[valueEnd - 1]))
+            --valueEnd;
+        if (quote && valueEnd - valueStart >= 2 && characters[valueStart] == quote && characters[valueEnd - 1] == quote) {
+            ++valueStart;
+            --valueEnd;
+        }
+        // Escapes are rare enough in style attributes that we leave those
+        // URLs for the real parser.
+        if (valueStart < valueEnd) {
+            String url(characters + valueStart, valueEnd - valueStart);
+            if (url.find('\\') == notFound)
+                urls.append(url);
+        }
+        position = end + 1;
+    }
+}
+
 void CSSPreloadScanner::emitRule()
 {
     if (equalIgnoringCase("import", m_rule.data(), m_rule.size())) {
         String value = parseCSSStringOrURL(m_ruleValue.data(), m_ruleValue.size());
-        if (!value.isEmpty())
+        if (!value.isEmpty()) {
+            if (!m_baseURL.isEmpty())
+                value = KURL(m_baseURL, value).string();
             m_document->cachedResourceLoader()->preload(CachedResource::CSSStyleSheet, value, String(), m_scanningBody);
+        }
         m_state = Initial;
     } else if (equalIgnoringCase("charset", m_rule.data(), m_rule.size()))
         m_state = Initial;
@@ -27,6 +27,7 @@
 #ifndef CSSPreloadScanner_h
 #define CSSPreloadScanner_h
 
+#include "KURL.h"
 #include "PlatformString.h"
 #include <wtf/Vector.h>
 
@@ -43,6 +44,14 @@ public:
     void reset();
     void scan(const HTMLToken&, bool scanningBody);
 
+    // Scans the text of a style sheet that was fetched but not yet parsed.
+    // Imported URLs are resolved against baseURL.
+    void scan(const String& sheetText, const KURL& baseURL);
+
+    // Appends the URLs of the url() values in a list of declarations, such
+    // as the contents of a style attribute.
+    static void collectURLsInDeclarations(const String& declarations, Vector<String>& urls);
+
 private:
     enum State {
         Initial,
@@ -57,6 +66,7 @@ private:
         DoneParsingImportRules,
     };
 
+    void scan(const UChar* begin, const UChar* end);
     inline void tokenize(UChar c);
     void emitRule();
 
@@ -65,6 +75,7 @@ private:
     Vector<UChar> m_ruleValue;
 
     bool m_scanningBody;
+    KURL m_baseURL;
     Document* m_document;
 };
 
@@ -85,6 +85,8 @@ HTMLDocumentParser::HTMLDocumentParser(HTMLDocument* document, bool reportErrors
     , m_treeBuilder(HTMLTreeBuilder::create(this, document, reportErrors, usePreHTML5ParserQuirks(document)))
     , m_parserScheduler(HTMLParserScheduler::create(this))
     , m_xssFilter(this)
+    , m_speculativeTokenIndex(0)
+    , m_consumedSpeculativeTokenCount(0)
     , m_endWasDelayed(false)
     , m_pumpSessionNestingLevel(0)
 {
@@ -97,6 +99,8 @@ HTMLDocumentParser::HTMLDocumentParser(DocumentFragment* fragment, Element* cont
     , m_tokenizer(HTMLTokenizer::create(usePreHTML5ParserQuirks(fragment->document())))
     , m_treeBuilder(HTMLTreeBuilder::create(this, fragment, contextElement, scriptingPermission, usePreHTML5ParserQuirks(fragment->document())))
     , m_xssFilter(this)
+    , m_speculativeTokenIndex(0)
+    , m_consumedSpeculativeTokenCount(0)
     , m_endWasDelayed(false)
     , m_pumpSessionNestingLevel(0)
 {
@@ -109,6 +113,7 @@ HTMLDocumentParser::~HTMLDocumentParser()
     ASSERT(!m_parserScheduler);
     ASSERT(!m_pumpSessionNestingLevel);
     ASSERT(!m_preloadScanner);
+    ASSERT(!m_backgroundTokenizer);
 }
 
 void HTMLDocumentParser::detach()
@@ -120,12 +125,15 @@ void HTMLDocumentParser::detach()
     // FIXME: It seems wrong that we would have a preload scanner here.
     // Yet during fast/dom/HTMLScriptElement/script-load-events.html we do.
     m_preloadScanner.clear();
+    stopBackgroundTokenizer();
+    m_speculativePreloadScanner.clear();
     m_parserScheduler.clear(); // Deleting the scheduler will clear any timers.
 }
 
 void HTMLDocumentParser::stopParsing()
 {
     DocumentParser::stopParsing();
+    stopBackgroundTokenizer();
     m_parserScheduler.clear(); // Deleting the scheduler will clear any timers.
 }
 
@@ -263,6 +271,12 @@ void HTMLDocumentParser::pumpTokenizer(SynchronousMode mode)
     InspectorInstrumentationCookie cookie = InspectorInstrumentation::willWriteHTML(document(), m_input.current().length(), m_tokenizer->lineNumber());
 
     while (canTakeNextToken(mode, session) && !session.needsYield) {
+        if (m_backgroundTokenizer) {
+            if (!processSpeculativeToken())
+                break;
+            continue;
+        }
+
         if (!isParsingFragment())
             m_sourceTracker.start(m_input, m_token);
 
@@ -285,13 +299,19 @@ void HTMLDocumentParser::pumpTokenizer(SynchronousMode mode)
     // function should be holding a RefPtr to this to ensure we weren't deleted.
     ASSERT(refCount() >= 1);
 
+    if (m_backgroundTokenizer && m_consumedSpeculativeTokenCount) {
+        m_backgroundTokenizer->didConsumeTokens(m_consumedSpeculativeTokenCount);
+        m_consumedSpeculativeTokenCount = 0;
+    }
+
     if (isStopped())
         return;
 
     if (session.needsYield)
         m_parserScheduler->scheduleForResume();
 
-    if (isWaitingForScripts()) {
+    // The speculative tokens were preload scanned as they arrived.
+    if (isWaitingForScripts() && !m_backgroundTokenizer) {
         ASSERT(m_tokenizer->state() == HTMLTokenizer::DataState);
         if (!m_preloadScanner) {
             m_preloadScanner.set(new HTMLPreloadScanner(document()));
@@ -303,6 +323,121 @@ void HTMLDocumentParser::pumpTokenizer(SynchronousMode mode)
     InspectorInstrumentation::didWriteHTML(cookie, m_tokenizer->lineNumber());
 }
 
+bool HTMLDocumentParser::shouldStartBackgroundTokenizer() const
+{
+    // Only network-sourced input at a clean token boundary is handed off.
+    // The background thread cannot see document.write() output or the tree
+    // builder state needed to resume inside RCDATA, RAWTEXT or foreign content.
+    Settings* settings = document()->settings();
+    if (!settings || !settings->threadedHTMLTokenizerEnabled())
+        return false;
+    if (isParsingFragment() || !m_scriptRunner || isWaitingForScripts() || inScriptExecution())
+        return false;
+    if (m_input.hasInsertionPoint() || m_input.haveSeenEndOfFile() || !m_input.current().isEmpty())
+        return false;
+    return m_token.type() == HTMLToken::Uninitialized
+        && m_tokenizer->state() == HTMLTokenizer::DataState
+        && !m_tokenizer->forceNullCharacterReplacement();
+}
+
+void HTMLDocumentParser::startBackgroundTokenizer()
+{
+    ASSERT(!m_backgroundTokenizer);
+    Frame* frame = document()->frame();
+    m_backgroundTokenizer = BackgroundHTMLTokenizer::create(this, usePreHTML5ParserQuirks(document()), HTMLTreeBuilder::scriptEnabled(frame), HTMLTreeBuilder::pluginsEnabled(frame));
+
+    HTMLTokenizer::Checkpoint checkpoint;
+    m_tokenizer->saveCheckpoint(checkpoint);
+    if (!m_backgroundTokenizer->start(checkpoint)) {
+        // Keep tokenizing on this thread.
+        m_backgroundTokenizer = 0;
+        return;
+    }
+
+    // The speculative tokens are scanned instead.
+    m_preloadScanner.clear();
+
+    if (!m_speculativePreloadScanner)
+        m_speculativePreloadScanner = adoptPtr(new HTMLPreloadScanner(document()));
+}
+
+void HTMLDocumentParser::stopBackgroundTokenizer()
+{
+    if (!m_backgroundTokenizer)
+        return;
+    m_backgroundTokenizer->stop();
+    m_backgroundTokenizer = 0;
+    m_speculativeTokens.clear();
+    m_speculativeTokenIndex = 0;
+    m_consumedSpeculativeTokenCount = 0;
+}
+
+void HTMLDocumentParser::didReceiveSpeculativeTokens()
+{
+    ASSERT(m_backgroundTokenizer);
+
+    // pumpTokenizer can cause this parser to be detached from the Document,
+    // but we need to ensure it isn't deleted yet.
+    RefPtr<HTMLDocumentParser> protect(this);
+
+    SpeculativeHTMLTokenVector tokens;
+    m_backgroundTokenizer->takeTokens(tokens);
+
+    if (m_speculativeTokenIndex == m_speculativeTokens.size()) {
+        m_speculativeTokens.clear();
+        m_speculativeTokenIndex = 0;
+    }
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        // Request subresources as soon as the tokens exist rather than when
+        // the tree builder, which may be blocked on a script, reaches them.
+        m_speculativePreloadScanner->scan(tokens[i]->token);
+        m_speculativeTokens.append(tokens[i].release());
+    }
+
+    if (inPumpSession())
+        return;
+
+    pumpTokenizerIfPossible(AllowYield);
+    endIfDelayed();
+}
+
+// Feeds one token from the background thread to the tree builder. Returns
+// false if no token is available yet.
+bool HTMLDocumentParser::processSpeculativeToken()
+{
+    ASSERT(m_backgroundTokenizer);
+    ASSERT(m_token.isUninitialized());
+    if (m_speculativeTokenIndex == m_speculativeTokens.size())
+        return false;
+
+    OwnPtr<SpeculativeHTMLToken> speculativeToken = m_speculativeTokens[m_speculativeTokenIndex++].release();
+    ++m_consumedSpeculativeTokenCount;
+    HTMLToken& token = speculativeToken->token;
+
+    m_sourceTracker.startSpeculativeToken(m_input);
+    int lineNumber = 0;
+    m_input.current().advance(speculativeToken->sourceLength, lineNumber);
+    m_tokenizer->restoreCheckpoint(speculativeToken->checkpoint);
+    m_xssFilter.filterToken(token);
+
+    bool isEndOfFile = token.type() == HTMLToken::EndOfFile;
+    m_treeBuilder->constructTreeFromToken(token);
+
+    if (isEndOfFile)
+        stopBackgroundTokenizer();
+    else if (m_backgroundTokenizer
+        && (m_tokenizer->state() != speculativeToken->speculatedState
+            || m_tokenizer->skipLeadingNewLineForListing() != speculativeToken->speculatedSkipLeadingNewLineForListing
+            || m_tokenizer->forceNullCharacterReplacement() != speculativeToken->speculatedForceNullCharacterReplacement
+            || m_tokenizer->shouldAllowCDATA() != speculativeToken->speculatedShouldAllowCDATA)) {
+        // The tree builder reacted differently than the background thread
+        // guessed, so the tokens after this one may be wrong. m_tokenizer
+        // now holds the correct state; continue synchronously from here.
+        stopBackgroundTokenizer();
+    }
+    return true;
+}
+
 bool HTMLDocumentParser::hasInsertionPoint()
 {
     // FIXME: The wasCreatedByScript() branch here might not be fully correct.
@@ -326,6 +461,11 @@ void HTMLDocumentParser::insert(const SegmentedString& source)
     // but we need to ensure it isn't deleted yet.
     RefPtr<HTMLDocumentParser> protect(this);
 
+    // document.write() changes the input the background thread is working
+    // on, so drop the speculation. m_input is positioned right after the
+    // last token the tree builder consumed.
+    stopBackgroundTokenizer();
+
     SegmentedString excludedLineNumberSource(source);
     excludedLineNumberSource.setExcludeLineNumbers();
     m_input.insertAtCurrentInsertionPoint(excludedLineNumberSource);
@@ -351,17 +491,12 @@ void HTMLDocumentParser::append(const SegmentedString& source)
     // but we need to ensure it isn't deleted yet.
     RefPtr<HTMLDocumentParser> protect(this);
 
-    if (m_preloadScanner) {
-        if (m_input.current().isEmpty() && !isWaitingForScripts()) {
-            // We have parsed until the end of the current input and so are now moving ahead of the preload scanner.
-            // Clear the scanner so we know to scan starting from the current input point if we block again.
-            m_preloadScanner.clear();
-        } else {
-            m_preloadScanner->appendToEnd(source);
-            if (isWaitingForScripts())
-                m_preloadScanner->scan();
-        }
-    }
+    if (!m_backgroundTokenizer && shouldStartBackgroundTokenizer())
+        startBackgroundTokenizer();
+    if (m_backgroundTokenizer)
+        m_backgroundTokenizer->append(source.toString());
+    else
+        scanAhead(source);
 
     m_input.appendToEnd(source);
 
@@ -383,6 +518,25 @@ void HTMLDocumentParser::append(const SegmentedString& source)
 #endif
 }
 
+// Without the background tokenizer, network input is only preload scanned
+// while the parser is blocked on a script. Otherwise the tree builder reaches
+// it soon anyway, and scanning it first would tokenize everything twice on
+// the main thread. pumpTokenizer() starts the scanner when the parser blocks.
+void HTMLDocumentParser::scanAhead(const SegmentedString& source)
+{
+    if (!m_preloadScanner)
+        return;
+    if (m_input.current().isEmpty() && !isWaitingForScripts()) {
+        // We have parsed until the end of the current input and so are now moving ahead of the preload scanner.
+        // Clear the scanner so we know to scan starting from the current input point if we block again.
+        m_preloadScanner.clear();
+        return;
+    }
+    m_preloadScanner->appendToEnd(source);
+    if (isWaitingForScripts())
+        m_preloadScanner->scan();
+}
+
 void HTMLDocumentParser::end()
 {
     ASSERT(!isDetached());
@@ -436,8 +590,11 @@ void HTMLDocumentParser::finish()
     // We're not going to get any more data off the network, so we tell the
     // input stream we've reached the end of file.  finish() can be called more
     // than once, if the first time does not call end().
-    if (!m_input.haveSeenEndOfFile())
+    if (!m_input.haveSeenEndOfFile()) {
         m_input.markEndOfFile();
+        if (m_backgroundTokenizer)
+            m_backgroundTokenizer->finish();
+    }
     attemptToEnd();
 }
 
@@ -26,6 +26,7 @@
 #ifndef HTMLDocumentParser_h
 #define HTMLDocumentParser_h
 
+#include "BackgroundHTMLTokenizer.h"
 #include "CachedResourceClient.h"
 #include "FragmentScriptingPermission.h"
 #include "HTMLInputStream.h"
@@ -53,7 +54,7 @@ class ScriptSourceCode;
 
 class PumpSession;
 
-class HTMLDocumentParser :  public ScriptableDocumentParser, HTMLScriptRunnerHost, CachedResourceClient {
+class HTMLDocumentParser :  public ScriptableDocumentParser, HTMLScriptRunnerHost, CachedResourceClient, BackgroundHTMLTokenizerClient {
     WTF_MAKE_FAST_ALLOCATED;
 public:
     static PassRefPtr<HTMLDocumentParser> create(HTMLDocument* document, bool reportErrors)
@@ -115,6 +116,9 @@ private:
     // CachedResourceClient
     virtual void notifyFinished(CachedResource*);
 
+    // BackgroundHTMLTokenizerClient
+    virtual void didReceiveSpeculativeTokens();
+
     enum SynchronousMode {
         AllowYield,
         ForceSynchronous,
@@ -123,6 +127,12 @@ private:
     void pumpTokenizer(SynchronousMode);
     void pumpTokenizerIfPossible(SynchronousMode);
 
+    bool shouldStartBackgroundTokenizer() const;
+    void startBackgroundTokenizer();
+    void stopBackgroundTokenizer();
+    void scanAhead(const SegmentedString&);
+    bool processSpeculativeToken();
+
     bool runScriptsForPausedTreeBuilder();
     void resumeParsingAfterScriptExecution();
 
@@ -136,7 +146,7 @@ private:
     bool isScheduledForResume() const;
     bool inScriptExecution() const;
     bool inPumpSession() const { return m_pumpSessionNestingLevel > 0; }
-    bool shouldDelayEnd() const { return inPumpSession() || isWaitingForScripts() || inScriptExecution() || isScheduledForResume(); }
+    bool shouldDelayEnd() const { return inPumpSession() || isWaitingForScripts() || inScriptExecution() || isScheduledForResume() || m_backgroundTokenizer; }
 
     ScriptController* script() const;
 
@@ -153,6 +163,16 @@ private:
     HTMLSourceTracker m_sourceTracker;
     XSSFilter m_xssFilter;
 
+    // Set while network input is being tokenized speculatively off the main
+    // thread. m_input remains authoritative: each consumed speculative token
+    // advances it, so dropping the speculation at any token boundary leaves
+    // m_input and m_tokenizer ready to continue synchronously.
+    RefPtr<BackgroundHTMLTokenizer> m_backgroundTokenizer;
+    SpeculativeHTMLTokenVector m_speculativeTokens;
+    size_t m_speculativeTokenIndex;
+    unsigned m_consumedSpeculativeTokenCount;
+    OwnPtr<HTMLPreloadScanner> m_speculativePreloadScanner;
+
     bool m_endWasDelayed;
     unsigned m_pumpSessionNestingLevel;
 };
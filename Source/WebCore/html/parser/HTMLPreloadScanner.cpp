@@ -58,14 +58,21 @@ public:
 
     void processAttributes(const HTMLToken::AttributeList& attributes)
     {
-        if (m_tagName != imgTag
-            && m_tagName != inputTag
-            && m_tagName != linkTag
-            && m_tagName != scriptTag)
-            return;
+        bool mayLoadResource = m_tagName == imgTag
+            || m_tagName == inputTag
+            || m_tagName == linkTag
+            || m_tagName == scriptTag;
 
         for (HTMLToken::AttributeList::const_iterator iter = attributes.begin();
              iter != attributes.end(); ++iter) {
+            // Any element can pull in images through its style attribute.
+            if (equalIgnoringNullity(iter->m_name, styleAttr.localName().impl())) {
+                CSSPreloadScanner::collectURLsInDeclarations(String(iter->m_value.data(), iter->m_value.size()), m_styleURLs);
+                continue;
+            }
+            if (!mayLoadResource)
+                continue;
+
             AtomicString attributeName(iter->m_name.data(), iter->m_name.size());
             String attributeValue(iter->m_value.data(), iter->m_value.size());
 
@@ -122,10 +129,16 @@ public:
 
     void preload(Document* document, bool scanningBody)
     {
+        CachedResourceLoader* cachedResourceLoader = document->cachedResourceLoader();
+
+        // Style images are usually decorative, so let the scheduler serve
+        // the resources the markup asked for directly before them.
+        for (size_t i = 0; i < m_styleURLs.size(); ++i)
+            cachedResourceLoader->preload(CachedResource::ImageResource, m_styleURLs[i], String(), scanningBody, ResourceLoadPriorityVeryLow);
+
         if (m_urlToLoad.isEmpty())
             return;
 
-        CachedResourceLoader* cachedResourceLoader = document->cachedResourceLoader();
         if (m_tagName == scriptTag)
             cachedResourceLoader->preload(CachedResource::Script, m_urlToLoad, m_charset, scanningBody);
         else if (m_tagName == imgTag || (m_tagName == inputTag && m_inputIsImage))
@@ -140,6 +153,7 @@ private:
     AtomicString m_tagName;
     String m_urlToLoad;
     String m_charset;
+    Vector<String> m_styleURLs;
     bool m_linkIsStyleSheet;
     bool m_linkMediaAttributeIsScreen;
     bool m_inputIsImage;
@@ -166,27 +180,35 @@ void HTMLPreloadScanner::scan()
     // FIXME: We should save and re-use these tokens in HTMLDocumentParser if
     // the pending script doesn't end up calling document.write.
     while (m_tokenizer->nextToken(m_source, m_token)) {
-        processToken();
+        AtomicString tagName = processToken(m_token);
+        if (!tagName.isNull())
+            m_tokenizer->updateStateFor(tagName, m_document->frame());
         m_token.clear();
     }
 }
 
-void HTMLPreloadScanner::processToken()
+void HTMLPreloadScanner::scan(const HTMLToken& token)
+{
+    processToken(token);
+}
+
+// Returns the tag name of a start tag token and a null atom otherwise, so
+// the caller can keep its tokenizer's state in sync.
+AtomicString HTMLPreloadScanner::processToken(const HTMLToken& token)
 {
     if (m_inStyle) {
-        if (m_token.type() == HTMLToken::Character)
-            m_cssScanner.scan(m_token, scanningBody());
-        else if (m_token.type() == HTMLToken::EndTag) {
+        if (token.type() == HTMLToken::Character)
+            m_cssScanner.scan(token, scanningBody());
+        else if (token.type() == HTMLToken::EndTag) {
             m_inStyle = false;
             m_cssScanner.reset();
         }
     }
 
-    if (m_token.type() != HTMLToken::StartTag)
-        return;
+    if (token.type() != HTMLToken::StartTag)
+        return nullAtom;
 
-    PreloadTask task(m_token);
-    m_tokenizer->updateStateFor(task.tagName(), m_document->frame());
+    PreloadTask task(token);
 
     if (task.tagName() == bodyTag)
         m_bodySeen = true;
@@ -195,6 +217,7 @@ void HTMLPreloadScanner::processToken()
         m_inStyle = true;
 
     task.preload(m_document, scanningBody());
+    return task.tagName();
 }
 
 bool HTMLPreloadScanner::scanningBody() const
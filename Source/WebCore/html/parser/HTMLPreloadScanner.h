@@ -46,8 +46,12 @@ public:
     void appendToEnd(const SegmentedString&);
     void scan();
 
+    // Scans a token that was produced by another tokenizer, such as the
+    // background tokenizer. The scanner's own tokenizer is not consulted.
+    void scan(const HTMLToken&);
+
 private:
-    void processToken();
+    AtomicString processToken(const HTMLToken&);
     bool scanningBody() const;
 
     Document* m_document;
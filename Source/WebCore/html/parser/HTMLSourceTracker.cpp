@@ -46,6 +46,13 @@ void HTMLSourceTracker::end(const HTMLInputStream& input, HTMLToken& token)
     token.end(input.current().numberOfCharactersConsumed());
 }
 
+void HTMLSourceTracker::startSpeculativeToken(const HTMLInputStream& input)
+{
+    m_sourceFromPreviousSegments = String();
+    m_source = input.current();
+    m_cachedSourceForToken = String();
+}
+
 String HTMLSourceTracker::sourceForToken(const HTMLToken& token)
 {
     if (token.type() == HTMLToken::EndOfFile)
@@ -42,6 +42,11 @@ public:
     void start(const HTMLInputStream&, HTMLToken&);
     void end(const HTMLInputStream&, HTMLToken&);
 
+    // For tokens produced by BackgroundHTMLTokenizer, which records the
+    // token's range itself. The token must start at the current position
+    // of the input stream.
+    void startSpeculativeToken(const HTMLInputStream&);
+
     String sourceForToken(const HTMLToken&);
 
 private:
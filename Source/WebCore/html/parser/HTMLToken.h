@@ -160,6 +160,12 @@ public:
         m_data.append(characters);
     }
 
+    void appendToCharacter(const UChar* characters, size_t length)
+    {
+        ASSERT(m_type == Character);
+        m_data.append(characters, length);
+    }
+
     void appendToComment(UChar character)
     {
         ASSERT(character);
@@ -167,6 +173,12 @@ public:
         m_data.append(character);
     }
 
+    void appendToComment(const UChar* characters, size_t length)
+    {
+        ASSERT(m_type == Comment);
+        m_data.append(characters, length);
+    }
+
     void addNewAttribute()
     {
         ASSERT(m_type == StartTag || m_type == EndTag);
@@ -222,6 +234,13 @@ public:
         m_currentAttribute->m_value.append(character);
     }
 
+    void appendToAttributeValue(const UChar* characters, size_t length)
+    {
+        ASSERT(m_type == StartTag || m_type == EndTag);
+        ASSERT(m_currentAttribute->m_valueRange.m_start);
+        m_currentAttribute->m_value.append(characters, length);
+    }
+
     void appendToAttributeValue(size_t i, const String& value)
     {
         ASSERT(!value.isEmpty());
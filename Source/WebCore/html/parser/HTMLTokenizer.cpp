@@ -35,6 +35,7 @@
 #include "NotImplemented.h"
 #include <wtf/ASCIICType.h>
 #include <wtf/CurrentTime.h>
+#include <wtf/MainThread.h>
 #include <wtf/UnusedParam.h>
 #include <wtf/text/AtomicString.h>
 #include <wtf/text/CString.h>
@@ -84,6 +85,37 @@ inline bool vectorEqualsString(const Vector<UChar, 32>& vector, const String& st
     return !memcmp(stringData, vectorData, vector.size() * sizeof(UChar));
 }
 
+// The characters InputStreamPreprocessor::peek() has to look at.
+inline bool isPreprocessedCharacter(UChar cc)
+{
+    return cc == '\n' || cc == '\r' || !cc;
+}
+
+inline bool endsDataRun(UChar cc)
+{
+    return cc == '<' || cc == '&' || isPreprocessedCharacter(cc);
+}
+
+inline bool endsRawTextRun(UChar cc)
+{
+    return cc == '<' || isPreprocessedCharacter(cc);
+}
+
+inline bool endsDoubleQuotedAttributeValueRun(UChar cc)
+{
+    return cc == '"' || cc == '&' || isPreprocessedCharacter(cc);
+}
+
+inline bool endsSingleQuotedAttributeValueRun(UChar cc)
+{
+    return cc == '\'' || cc == '&' || isPreprocessedCharacter(cc);
+}
+
+inline bool endsCommentRun(UChar cc)
+{
+    return cc == '-' || isPreprocessedCharacter(cc);
+}
+
 inline bool isEndTagBufferingState(HTMLTokenizer::State state)
 {
     switch (state) {
@@ -101,12 +133,57 @@ inline bool isEndTagBufferingState(HTMLTokenizer::State state)
     }
 }
 
+// These keywords are shared by every tokenizer, including the one
+// BackgroundHTMLTokenizer runs on its own thread. The HTMLTokenizer
+// constructor builds them on the main thread, so the tokenizer thread only
+// ever reads them.
+const String& dashDashString()
+{
+    DEFINE_STATIC_LOCAL(String, string, ("--"));
+    return string;
+}
+
+const String& doctypeString()
+{
+    DEFINE_STATIC_LOCAL(String, string, ("doctype"));
+    return string;
+}
+
+const String& cdataString()
+{
+    DEFINE_STATIC_LOCAL(String, string, ("[CDATA["));
+    return string;
+}
+
+const String& publicString()
+{
+    DEFINE_STATIC_LOCAL(String, string, ("public"));
+    return string;
+}
+
+const String& systemString()
+{
+    DEFINE_STATIC_LOCAL(String, string, ("system"));
+    return string;
+}
+
+void initializeKeywordStrings()
+{
+    ASSERT(isMainThread());
+    dashDashString();
+    doctypeString();
+    cdataString();
+    publicString();
+    systemString();
+}
+
 }
 
 HTMLTokenizer::HTMLTokenizer(bool usePreHTML5ParserQuirks)
     : m_inputStreamPreprocessor(this)
     , m_usePreHTML5ParserQuirks(usePreHTML5ParserQuirks)
 {
+    initializeKeywordStrings();
     reset();
 }
 
@@ -125,6 +202,35 @@ void HTMLTokenizer::reset()
     m_additionalAllowedCharacter = '\0';
 }
 
+void HTMLTokenizer::saveCheckpoint(Checkpoint& checkpoint) const
+{
+    checkpoint.state = m_state;
+    checkpoint.lineNumber = m_lineNumber;
+    checkpoint.skipLeadingNewLineForListing = m_skipLeadingNewLineForListing;
+    checkpoint.forceNullCharacterReplacement = m_forceNullCharacterReplacement;
+    checkpoint.shouldAllowCDATA = m_shouldAllowCDATA;
+    checkpoint.skipNextNewLine = m_inputStreamPreprocessor.skipNextNewLine();
+    checkpoint.additionalAllowedCharacter = m_additionalAllowedCharacter;
+    checkpoint.appropriateEndTagName = m_appropriateEndTagName;
+    checkpoint.temporaryBuffer = m_temporaryBuffer;
+    checkpoint.bufferedEndTagName = m_bufferedEndTagName;
+}
+
+void HTMLTokenizer::restoreCheckpoint(const Checkpoint& checkpoint)
+{
+    m_state = checkpoint.state;
+    m_token = 0;
+    m_lineNumber = checkpoint.lineNumber;
+    m_skipLeadingNewLineForListing = checkpoint.skipLeadingNewLineForListing;
+    m_forceNullCharacterReplacement = checkpoint.forceNullCharacterReplacement;
+    m_shouldAllowCDATA = checkpoint.shouldAllowCDATA;
+    m_inputStreamPreprocessor.setSkipNextNewLine(checkpoint.skipNextNewLine);
+    m_additionalAllowedCharacter = checkpoint.additionalAllowedCharacter;
+    m_appropriateEndTagName = checkpoint.appropriateEndTagName;
+    m_temporaryBuffer = checkpoint.temporaryBuffer;
+    m_bufferedEndTagName = checkpoint.bufferedEndTagName;
+}
+
 inline bool HTMLTokenizer::processEntity(SegmentedString& source)
 {
     bool notEnoughCharacters = false;
@@ -255,6 +361,23 @@ bool HTMLTokenizer::flushEmitAndResumeIn(SegmentedString& source, State state)
     return true;
 }
 
+template<bool isRunTerminator(UChar)>
+inline size_t HTMLTokenizer::consumeCharacterRun(SegmentedString& source, const UChar*& run)
+{
+    unsigned available;
+    run = source.charactersAfterCurrent(available);
+    size_t length = 0;
+    while (length < available && !isRunTerminator(run[length]))
+        ++length;
+    if (!length)
+        return 0;
+    // None of the characters in the run is a newline, so no line numbers
+    // change, and peek() would have cleared any pending \r\n collapse.
+    source.advancePastNonNewlines(length);
+    m_inputStreamPreprocessor.setSkipNextNewLine(false);
+    return length;
+}
+
 bool HTMLTokenizer::nextToken(SegmentedString& source, HTMLToken& token)
 {
     // If we have a token in progress, then we're supposed to be called back
@@ -317,6 +440,9 @@ bool HTMLTokenizer::nextToken(SegmentedString& source, HTMLToken& token)
             return emitEndOfFile(source);
         else {
             bufferCharacter(cc);
+            const UChar* run;
+            if (size_t length = consumeCharacterRun<endsDataRun>(source, run))
+                m_token->appendToCharacter(run, length);
             ADVANCE_TO(DataState);
         }
     }
@@ -338,6 +464,9 @@ bool HTMLTokenizer::nextToken(SegmentedString& source, HTMLToken& token)
             return emitEndOfFile(source);
         else {
             bufferCharacter(cc);
+            const UChar* run;
+            if (size_t length = consumeCharacterRun<endsDataRun>(source, run))
+                m_token->appendToCharacter(run, length);
             ADVANCE_TO(RCDATAState);
         }
     }
@@ -357,6 +486,9 @@ bool HTMLTokenizer::nextToken(SegmentedString& source, HTMLToken& token)
             return emitEndOfFile(source);
         else {
             bufferCharacter(cc);
+            const UChar* run;
+            if (size_t length = consumeCharacterRun<endsRawTextRun>(source, run))
+                m_token->appendToCharacter(run, length);
             ADVANCE_TO(RAWTEXTState);
         }
     }
@@ -369,6 +501,9 @@ bool HTMLTokenizer::nextToken(SegmentedString& source, HTMLToken& token)
             return emitEndOfFile(source);
         else {
             bufferCharacter(cc);
+            const UChar* run;
+            if (size_t length = consumeCharacterRun<endsRawTextRun>(source, run))
+                m_token->appendToCharacter(run, length);
             ADVANCE_TO(ScriptDataState);
         }
     }
@@ -1004,6 +1139,9 @@ bool HTMLTokenizer::nextToken(SegmentedString& source, HTMLToken& token)
             RECONSUME_IN(DataState);
         } else {
             m_token->appendToAttributeValue(cc);
+            const UChar* run;
+            if (size_t length = consumeCharacterRun<endsDoubleQuotedAttributeValueRun>(source, run))
+                m_token->appendToAttributeValue(run, length);
             ADVANCE_TO(AttributeValueDoubleQuotedState);
         }
     }
@@ -1022,6 +1160,9 @@ bool HTMLTokenizer::nextToken(SegmentedString& source, HTMLToken& token)
             RECONSUME_IN(DataState);
         } else {
             m_token->appendToAttributeValue(cc);
+            const UChar* run;
+            if (size_t length = consumeCharacterRun<endsSingleQuotedAttributeValueRun>(source, run))
+                m_token->appendToAttributeValue(run, length);
             ADVANCE_TO(AttributeValueSingleQuotedState);
         }
     }
@@ -1131,11 +1272,8 @@ bool HTMLTokenizer::nextToken(SegmentedString& source, HTMLToken& token)
     END_STATE()
 
     BEGIN_STATE(MarkupDeclarationOpenState) {
-        DEFINE_STATIC_LOCAL(String, dashDashString, ("--"));
-        DEFINE_STATIC_LOCAL(String, doctypeString, ("doctype"));
-        DEFINE_STATIC_LOCAL(String, cdataString, ("[CDATA["));
         if (cc == '-') {
-            SegmentedString::LookAheadResult result = source.lookAhead(dashDashString);
+            SegmentedString::LookAheadResult result = source.lookAhead(dashDashString());
             if (result == SegmentedString::DidMatch) {
                 source.advanceAndASSERT('-');
                 source.advanceAndASSERT('-');
@@ -1144,14 +1282,14 @@ bool HTMLTokenizer::nextToken(SegmentedString& source, HTMLToken& token)
             } else if (result == SegmentedString::NotEnoughCharacters)
                 return haveBufferedCharacterToken();
         } else if (cc == 'D' || cc == 'd') {
-            SegmentedString::LookAheadResult result = source.lookAheadIgnoringCase(doctypeString);
+            SegmentedString::LookAheadResult result = source.lookAheadIgnoringCase(doctypeString());
             if (result == SegmentedString::DidMatch) {
                 advanceStringAndASSERTIgnoringCase(source, "doctype");
                 SWITCH_TO(DOCTYPEState);
             } else if (result == SegmentedString::NotEnoughCharacters)
                 return haveBufferedCharacterToken();
         } else if (cc == '[' && shouldAllowCDATA()) {
-            SegmentedString::LookAheadResult result = source.lookAhead(cdataString);
+            SegmentedString::LookAheadResult result = source.lookAhead(cdataString());
             if (result == SegmentedString::DidMatch) {
                 advanceStringAndASSERT(source, "[CDATA[");
                 SWITCH_TO(CDATASectionState);
@@ -1204,6 +1342,9 @@ bool HTMLTokenizer::nextToken(SegmentedString& source, HTMLToken& token)
             return emitAndReconsumeIn(source, DataState);
         } else {
             m_token->appendToComment(cc);
+            const UChar* run;
+            if (size_t length = consumeCharacterRun<endsCommentRun>(source, run))
+                m_token->appendToComment(run, length);
             ADVANCE_TO(CommentState);
         }
     }
@@ -1334,17 +1475,15 @@ bool HTMLTokenizer::nextToken(SegmentedString& source, HTMLToken& token)
             m_token->setForceQuirks();
             return emitAndReconsumeIn(source, DataState);
         } else {
-            DEFINE_STATIC_LOCAL(String, publicString, ("public"));
-            DEFINE_STATIC_LOCAL(String, systemString, ("system"));
             if (cc == 'P' || cc == 'p') {
-                SegmentedString::LookAheadResult result = source.lookAheadIgnoringCase(publicString);
+                SegmentedString::LookAheadResult result = source.lookAheadIgnoringCase(publicString());
                 if (result == SegmentedString::DidMatch) {
                     advanceStringAndASSERTIgnoringCase(source, "public");
                     SWITCH_TO(AfterDOCTYPEPublicKeywordState);
                 } else if (result == SegmentedString::NotEnoughCharacters)
                     return haveBufferedCharacterToken();
             } else if (cc == 'S' || cc == 's') {
-                SegmentedString::LookAheadResult result = source.lookAheadIgnoringCase(systemString);
+                SegmentedString::LookAheadResult result = source.lookAheadIgnoringCase(systemString());
                 if (result == SegmentedString::DidMatch) {
                     advanceStringAndASSERTIgnoringCase(source, "system");
                     SWITCH_TO(AfterDOCTYPESystemKeywordState);
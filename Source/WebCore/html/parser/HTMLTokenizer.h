@@ -130,6 +130,25 @@ public:
     // they call reset() first).
     bool nextToken(SegmentedString&, HTMLToken&);
 
+    // A snapshot of the tokenizer taken between two tokens. Restoring it into
+    // another tokenizer lets that tokenizer resume exactly where this one
+    // stopped, provided it is fed the same input from the same point.
+    struct Checkpoint {
+        State state;
+        int lineNumber;
+        bool skipLeadingNewLineForListing;
+        bool forceNullCharacterReplacement;
+        bool shouldAllowCDATA;
+        bool skipNextNewLine;
+        UChar additionalAllowedCharacter;
+        Vector<UChar, 32> appropriateEndTagName;
+        Vector<UChar, 32> temporaryBuffer;
+        Vector<UChar, 32> bufferedEndTagName;
+    };
+
+    void saveCheckpoint(Checkpoint&) const;
+    void restoreCheckpoint(const Checkpoint&);
+
     int lineNumber() const { return m_lineNumber; }
     int columnNumber() const { return 1; } // Matches LegacyHTMLDocumentParser.h behavior.
 
@@ -154,6 +173,7 @@ public:
 
     // Hack to skip leading newline in <pre>/<listing> for authoring ease.
     // http://www.whatwg.org/specs/web-apps/current-work/multipage/tokenization.html#parsing-main-inbody
+    bool skipLeadingNewLineForListing() const { return m_skipLeadingNewLineForListing; }
     void setSkipLeadingNewLineForListing(bool value) { m_skipLeadingNewLineForListing = value; }
 
     bool forceNullCharacterReplacement() const { return m_forceNullCharacterReplacement; }
@@ -185,6 +205,9 @@ private:
 
         UChar nextInputCharacter() const { return m_nextInputCharacter; }
 
+        bool skipNextNewLine() const { return m_skipNextNewLine; }
+        void setSkipNextNewLine(bool value) { m_skipNextNewLine = value; }
+
         // Returns whether we succeeded in peeking at the next character.
         // The only way we can fail to peek is if there are no more
         // characters in |source| (after collapsing \r\n, etc).
@@ -283,6 +306,14 @@ private:
 
     inline bool haveBufferedCharacterToken();
 
+    // Most input in the text, attribute value and comment states is simply
+    // appended to the token. This consumes the run of such characters after
+    // the current one, stopping before any character that isRunTerminator()
+    // accepts, so the caller can append them in bulk. |source| is left on
+    // the last character of the run for the caller's ADVANCE_TO.
+    template<bool isRunTerminator(UChar)>
+    inline size_t consumeCharacterRun(SegmentedString&, const UChar*& run);
+
     State m_state;
 
     Vector<UChar, 32> m_appropriateEndTagName;
@@ -331,10 +331,10 @@ InspectorInstrumentationCookie InspectorInstrumentation::willLayoutImpl(Inspecto
     return InspectorInstrumentationCookie(inspectorAgent, timelineAgentId);
 }
 
-void InspectorInstrumentation::didLayoutImpl(const InspectorInstrumentationCookie& cookie)
+void InspectorInstrumentation::didLayoutImpl(const InspectorInstrumentationCookie& cookie, const LayoutStatistics& statistics)
 {
     if (InspectorTimelineAgent* timelineAgent = retrieveTimelineAgent(cookie))
-        timelineAgent->didLayout();
+        timelineAgent->didLayout(statistics);
 }
 
 InspectorInstrumentationCookie InspectorInstrumentation::willLoadXHRImpl(InspectorAgent* inspectorAgent, XMLHttpRequest* request)
@@ -52,6 +52,7 @@ class InspectorPageAgent;
 class InspectorResourceAgent;
 class InspectorTimelineAgent;
 class KURL;
+class LayoutStatistics;
 class Node;
 class ResourceRequest;
 class ResourceResponse;
@@ -102,7 +103,8 @@ public:
     static InspectorInstrumentationCookie willFireTimer(ScriptExecutionContext*, int timerId);
     static void didFireTimer(const InspectorInstrumentationCookie&);
     static InspectorInstrumentationCookie willLayout(Frame*);
-    static void didLayout(const InspectorInstrumentationCookie&);
+    static bool collectsLayoutStatistics(const InspectorInstrumentationCookie&);
+    static void didLayout(const InspectorInstrumentationCookie&, const LayoutStatistics&);
     static InspectorInstrumentationCookie willLoadXHR(ScriptExecutionContext*, XMLHttpRequest*);
     static void didLoadXHR(const InspectorInstrumentationCookie&);
     static InspectorInstrumentationCookie willPaint(Frame*, const IntRect& rect);
@@ -221,7 +223,7 @@ private:
     static InspectorInstrumentationCookie willFireTimerImpl(InspectorAgent*, int timerId);
     static void didFireTimerImpl(const InspectorInstrumentationCookie&);
     static InspectorInstrumentationCookie willLayoutImpl(InspectorAgent*);
-    static void didLayoutImpl(const InspectorInstrumentationCookie&);
+    static void didLayoutImpl(const InspectorInstrumentationCookie&, const LayoutStatistics&);
     static InspectorInstrumentationCookie willLoadXHRImpl(InspectorAgent*, XMLHttpRequest* request);
     static void didLoadXHRImpl(const InspectorInstrumentationCookie&);
     static InspectorInstrumentationCookie willPaintImpl(InspectorAgent*, const IntRect& rect);
@@ -549,11 +551,22 @@ inline InspectorInstrumentationCookie InspectorInstrumentation::willLayout(Frame
     return InspectorInstrumentationCookie();
 }
 
-inline void InspectorInstrumentation::didLayout(const InspectorInstrumentationCookie& cookie)
+// The timeline is the only consumer of LayoutStatistics, and the cookie only
+// carries a timeline agent id while the timeline is recording.
+inline bool InspectorInstrumentation::collectsLayoutStatistics(const InspectorInstrumentationCookie& cookie)
+{
+#if ENABLE(INSPECTOR)
+    return cookie.first && cookie.second;
+#else
+    return false;
+#endif
+}
+
+inline void InspectorInstrumentation::didLayout(const InspectorInstrumentationCookie& cookie, const LayoutStatistics& statistics)
 {
 #if ENABLE(INSPECTOR)
     if (hasFrontends() && cookie.first)
-        didLayoutImpl(cookie);
+        didLayoutImpl(cookie, statistics);
 #endif
 }
 
@@ -38,6 +38,7 @@
 #include "InspectorState.h"
 #include "InstrumentingAgents.h"
 #include "IntRect.h"
+#include "LayoutStatistics.h"
 #include "ResourceRequest.h"
 #include "ResourceResponse.h"
 #include "TimelineRecordFactory.h"
@@ -181,8 +182,10 @@ void InspectorTimelineAgent::willLayout()
     pushCurrentRecord(InspectorObject::create(), TimelineRecordType::Layout);
 }
 
-void InspectorTimelineAgent::didLayout()
+void InspectorTimelineAgent::didLayout(const LayoutStatistics& statistics)
 {
+    if (!m_recordStack.isEmpty() && statistics.wasCollected())
+        m_recordStack.last().data = TimelineRecordFactory::createLayoutData(statistics);
     didCompleteCurrentRecord(TimelineRecordType::Layout);
 }
 
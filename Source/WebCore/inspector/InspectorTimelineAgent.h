@@ -46,6 +46,7 @@ class InspectorFrontend;
 class InspectorState;
 class InstrumentingAgents;
 class IntRect;
+class LayoutStatistics;
 class ResourceRequest;
 class ResourceResponse;
 
@@ -81,7 +82,7 @@ public:
     void didDispatchEvent();
 
     void willLayout();
-    void didLayout();
+    void didLayout(const LayoutStatistics&);
 
     void willRecalculateStyle();
     void didRecalculateStyle();
@@ -36,6 +36,7 @@
 #include "Event.h"
 #include "InspectorValues.h"
 #include "IntRect.h"
+#include "LayoutStatistics.h"
 #include "ResourceRequest.h"
 #include "ResourceResponse.h"
 #include "ScriptCallStack.h"
@@ -164,6 +165,22 @@ PassRefPtr<InspectorObject> TimelineRecordFactory::createReceiveResourceData(uns
     return data.release();
 }
     
+PassRefPtr<InspectorObject> TimelineRecordFactory::createLayoutData(const LayoutStatistics& statistics)
+{
+    RefPtr<InspectorObject> data = InspectorObject::create();
+    data->setString("root", statistics.rootName());
+    data->setBoolean("subtree", statistics.isSubtree());
+    data->setString("trigger", LayoutStatistics::triggerName(statistics.trigger()));
+    data->setBoolean("synchronous", statistics.isSynchronous());
+    data->setNumber("objectCount", statistics.objectCount());
+    data->setNumber("selfNeedsLayoutCount", statistics.selfNeedsLayoutCount());
+    data->setNumber("lineCount", statistics.lineCount());
+    data->setNumber("inlineBoxCount", statistics.inlineBoxCount());
+    data->setNumber("blockLayoutTime", statistics.blockLayoutTime() * 1000);
+    data->setNumber("lineLayoutTime", statistics.lineLayoutTime() * 1000);
+    return data.release();
+}
+
 PassRefPtr<InspectorObject> TimelineRecordFactory::createPaintData(const IntRect& rect)
 {
     RefPtr<InspectorObject> data = InspectorObject::create();
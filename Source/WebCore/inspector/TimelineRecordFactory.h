@@ -39,6 +39,7 @@ namespace WebCore {
     class InspectorFrontend;
     class InspectorObject;
     class IntRect;
+    class LayoutStatistics;
     class ResourceRequest;
     class ResourceResponse;
 
@@ -74,6 +75,8 @@ namespace WebCore {
 
         static PassRefPtr<InspectorObject> createResourceFinishData(unsigned long identifier, bool didFail, double finishTime);
 
+        static PassRefPtr<InspectorObject> createLayoutData(const LayoutStatistics&);
+
         static PassRefPtr<InspectorObject> createPaintData(const IntRect&);
 
         static PassRefPtr<InspectorObject> createParseHTMLData(unsigned int length, unsigned int startLine);
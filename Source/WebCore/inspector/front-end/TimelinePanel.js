@@ -989,6 +989,16 @@ WebInspector.TimelinePanel.FormattedRecord.prototype = {
                 if (this.data && this.data.url)
                     contentHelper._appendLinkRow(WebInspector.UIString("Script"), this.data.url, this.data.lineNumber);
                 break;
+            case recordTypes.Layout:
+                if (!this.data.trigger)
+                    break;
+                contentHelper._appendTextRow(WebInspector.UIString("Root"), this.data.subtree ? WebInspector.UIString("%s (subtree)", this.data.root) : this.data.root);
+                contentHelper._appendTextRow(WebInspector.UIString("Trigger"), this.data.synchronous ? WebInspector.UIString("%s (forced)", this.data.trigger) : this.data.trigger);
+                contentHelper._appendTextRow(WebInspector.UIString("Objects Laid Out"), WebInspector.UIString("%d (%d dirty)", this.data.objectCount, this.data.selfNeedsLayoutCount));
+                contentHelper._appendTextRow(WebInspector.UIString("Lines Built"), this.data.lineCount);
+                contentHelper._appendTextRow(WebInspector.UIString("Block Layout"), Number.secondsToString(this.data.blockLayoutTime / 1000, true));
+                contentHelper._appendTextRow(WebInspector.UIString("Line Layout"), Number.secondsToString(this.data.lineLayoutTime / 1000, true));
+                break;
             case recordTypes.Paint:
                 contentHelper._appendTextRow(WebInspector.UIString("Location"), WebInspector.UIString("(%d, %d)", this.data.x, this.data.y));
                 contentHelper._appendTextRow(WebInspector.UIString("Dimensions"), WebInspector.UIString("%d × %d", this.data.width, this.data.height));
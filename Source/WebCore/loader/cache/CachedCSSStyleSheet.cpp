@@ -27,6 +27,7 @@
 #include "config.h"
 #include "CachedCSSStyleSheet.h"
 
+#include "CSSStyleSheet.h"
 #include "MemoryCache.h"
 #include "CachedResourceClient.h"
 #include "CachedResourceClientWalker.h"
@@ -40,6 +41,9 @@ namespace WebCore {
 CachedCSSStyleSheet::CachedCSSStyleSheet(const String& url, const String& charset)
     : CachedResource(url, CSSStyleSheet)
     , m_decoder(TextResourceDecoder::create("text/css", charset))
+    , m_sharedParsedSheetIsStrict(false)
+    , m_sharedParsedSheetEnforcedMIMEType(false)
+    , m_sharedParsedSheetIsHTMLDocument(false)
 {
     // Prefer text/css but accept any type (dell.com serves a stylesheet
     // as text/html; see <http://bugs.webkit.org/show_bug.cgi?id=11451>).
@@ -65,6 +69,7 @@ void CachedCSSStyleSheet::allClientsRemoved()
 void CachedCSSStyleSheet::setEncoding(const String& chs)
 {
     m_decoder->setEncoding(chs, TextResourceDecoder::EncodingFromHTTPHeader);
+    destroyDecodedData();
 }
 
 String CachedCSSStyleSheet::encoding() const
@@ -95,6 +100,7 @@ void CachedCSSStyleSheet::data(PassRefPtr<SharedBuffer> data, bool allDataReceiv
 
     m_data = data;
     setEncodedSize(m_data.get() ? m_data->size() : 0);
+    destroyDecodedData();
     // Decode the data to find out the encoding and keep the sheet text around during checkNotify()
     if (m_data) {
         m_decodedSheetText = m_decoder->decode(m_data->data(), m_data->size());
@@ -106,6 +112,30 @@ void CachedCSSStyleSheet::data(PassRefPtr<SharedBuffer> data, bool allDataReceiv
     m_decodedSheetText = String();
 }
 
+WebCore::CSSStyleSheet* CachedCSSStyleSheet::sharedParsedSheet(bool strictParsing, bool enforceMIMEType, bool isHTMLDocument) const
+{
+    if (!m_sharedParsedSheet || m_sharedParsedSheetIsStrict != strictParsing || m_sharedParsedSheetEnforcedMIMEType != enforceMIMEType
+        || m_sharedParsedSheetIsHTMLDocument != isHTMLDocument)
+        return 0;
+    return m_sharedParsedSheet.get();
+}
+
+void CachedCSSStyleSheet::setSharedParsedSheet(PassRefPtr<WebCore::CSSStyleSheet> sheet, bool strictParsing, bool enforceMIMEType, bool isHTMLDocument, unsigned textLength) const
+{
+    m_sharedParsedSheet = sheet;
+    m_sharedParsedSheetIsStrict = strictParsing;
+    m_sharedParsedSheetEnforcedMIMEType = enforceMIMEType;
+    m_sharedParsedSheetIsHTMLDocument = isHTMLDocument;
+    // The shared sheet keeps the text of its deferred declarations alive.
+    const_cast<CachedCSSStyleSheet*>(this)->setDecodedSize(textLength * sizeof(UChar));
+}
+
+void CachedCSSStyleSheet::destroyDecodedData()
+{
+    m_sharedParsedSheet = 0;
+    setDecodedSize(0);
+}
+
 void CachedCSSStyleSheet::checkNotify()
 {
     if (isLoading())
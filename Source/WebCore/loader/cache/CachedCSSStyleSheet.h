@@ -32,6 +32,7 @@
 
 namespace WebCore {
 
+    class CSSStyleSheet;
     class CachedResourceLoader;
     class TextResourceDecoder;
 
@@ -52,7 +53,19 @@ namespace WebCore {
         virtual void error(CachedResource::Status);
 
         void checkNotify();
-    
+
+        // The parsed contents of this resource, for documents that load it
+        // later to copy rather than parse the text again. The contents are
+        // never exposed to script, so CSSOM changes to a document's copy
+        // leave them alone. They are dropped when the data changes or the
+        // memory cache reclaims decoded data. Selectors are parsed
+        // differently for HTML documents, so the document type is part of
+        // the key along with the parsing mode.
+        WebCore::CSSStyleSheet* sharedParsedSheet(bool strictParsing, bool enforceMIMEType, bool isHTMLDocument) const;
+        void setSharedParsedSheet(PassRefPtr<WebCore::CSSStyleSheet>, bool strictParsing, bool enforceMIMEType, bool isHTMLDocument, unsigned textLength) const;
+
+        virtual void destroyDecodedData();
+
     private:
         bool canUseSheet(bool enforceMIMEType, bool* hasValidMIMEType) const;
         virtual PurgePriority purgePriority() const { return PurgeLast; }
@@ -60,6 +73,11 @@ namespace WebCore {
     protected:
         RefPtr<TextResourceDecoder> m_decoder;
         String m_decodedSheetText;
+
+        mutable RefPtr<WebCore::CSSStyleSheet> m_sharedParsedSheet;
+        mutable bool m_sharedParsedSheetIsStrict;
+        mutable bool m_sharedParsedSheetEnforcedMIMEType;
+        mutable bool m_sharedParsedSheetIsHTMLDocument;
     };
 
 }
@@ -27,6 +27,7 @@
 #include "config.h"
 #include "CachedResourceLoader.h"
 
+#include "CSSPreloadScanner.h"
 #include "CachedCSSStyleSheet.h"
 #include "CachedFont.h"
 #include "CachedImage.h"
@@ -674,7 +675,7 @@ int CachedResourceLoader::requestCount()
     return m_requestCount;
 }
     
-void CachedResourceLoader::preload(CachedResource::Type type, const String& url, const String& charset, bool referencedFromBody)
+void CachedResourceLoader::preload(CachedResource::Type type, const String& url, const String& charset, bool referencedFromBody, ResourceLoadPriority priority)
 {
     // FIXME: Rip this out when we are sure it is no longer necessary (even for mobile).
     UNUSED_PARAM(referencedFromBody);
@@ -684,11 +685,26 @@ void CachedResourceLoader::preload(CachedResource::Type type, const String& url,
     if (!hasRendering && !canBlockParser) {
         // Don't preload subresources that can't block the parser before we have something to draw.
         // This helps prevent preloads from delaying first display when bandwidth is limited.
-        PendingPreload pendingPreload = { type, url, charset };
+        PendingPreload pendingPreload = { type, url, charset, priority };
         m_pendingPreloads.append(pendingPreload);
         return;
     }
-    requestPreload(type, url, charset);
+    requestPreload(type, url, charset, priority);
+}
+
+void CachedResourceLoader::preloadImportedStyleSheets(CachedCSSStyleSheet* sheet)
+{
+    // A preloaded style sheet is not parsed until the parser reaches the
+    // element that references it, so request its imports now rather than
+    // discovering each level of an @import chain one round trip at a time.
+    // The imported sheets are preloads themselves and continue the chain.
+    if (!m_document)
+        return;
+    String sheetText = sheet->sheetText();
+    if (sheetText.isEmpty())
+        return;
+    CSSPreloadScanner scanner(m_document);
+    scanner.scan(sheetText, KURL(ParsedURLString, sheet->url()));
 }
 
 void CachedResourceLoader::checkForPendingPreloads() 
@@ -699,18 +715,18 @@ void CachedResourceLoader::checkForPendingPreloads()
         PendingPreload preload = m_pendingPreloads.takeFirst();
         // Don't request preload if the resource already loaded normally (this will result in double load if the page is being reloaded with cached results ignored).
         if (!cachedResource(m_document->completeURL(preload.m_url)))
-            requestPreload(preload.m_type, preload.m_url, preload.m_charset);
+            requestPreload(preload.m_type, preload.m_url, preload.m_charset, preload.m_priority);
     }
     m_pendingPreloads.clear();
 }
 
-void CachedResourceLoader::requestPreload(CachedResource::Type type, const String& url, const String& charset)
+void CachedResourceLoader::requestPreload(CachedResource::Type type, const String& url, const String& charset, ResourceLoadPriority priority)
 {
     String encoding;
     if (type == CachedResource::Script || type == CachedResource::CSSStyleSheet)
         encoding = charset.isEmpty() ? m_document->charset() : charset;
 
-    CachedResource* resource = requestResource(type, url, encoding, ResourceLoadPriorityUnresolved, true);
+    CachedResource* resource = requestResource(type, url, encoding, priority, true);
     if (!resource || (m_preloads && m_preloads->contains(resource)))
         return;
     resource->increasePreloadCount();
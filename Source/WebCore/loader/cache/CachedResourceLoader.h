@@ -110,7 +110,8 @@ public:
     
     void clearPreloads();
     void clearPendingPreloads();
-    void preload(CachedResource::Type, const String& url, const String& charset, bool referencedFromBody);
+    void preload(CachedResource::Type, const String& url, const String& charset, bool referencedFromBody, ResourceLoadPriority = ResourceLoadPriorityUnresolved);
+    void preloadImportedStyleSheets(CachedCSSStyleSheet*);
     void checkForPendingPreloads();
     void printPreloadStats();
     
@@ -118,7 +119,7 @@ private:
     CachedResource* requestResource(CachedResource::Type, const String& url, const String& charset, ResourceLoadPriority priority = ResourceLoadPriorityUnresolved, bool isPreload = false);
     CachedResource* revalidateResource(CachedResource*, ResourceLoadPriority priority);
     CachedResource* loadResource(CachedResource::Type, const KURL&, const String& charset, ResourceLoadPriority priority);
-    void requestPreload(CachedResource::Type, const String& url, const String& charset);
+    void requestPreload(CachedResource::Type, const String& url, const String& charset, ResourceLoadPriority);
 
     enum RevalidationPolicy { Use, Revalidate, Reload, Load };
     RevalidationPolicy determineRevalidationPolicy(CachedResource::Type, bool forPreload, CachedResource* existingResource) const;
@@ -144,6 +145,7 @@ private:
         CachedResource::Type m_type;
         String m_url;
         String m_charset;
+        ResourceLoadPriority m_priority;
     };
     Deque<PendingPreload> m_pendingPreloads;
 
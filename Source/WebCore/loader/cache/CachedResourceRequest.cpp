@@ -25,6 +25,7 @@
 #include "CachedResourceRequest.h"
 
 #include "MemoryCache.h"
+#include "CachedCSSStyleSheet.h"
 #include "CachedImage.h"
 #include "CachedResource.h"
 #include "CachedResourceLoader.h"
@@ -163,8 +164,11 @@ void CachedResourceRequest::didFinishLoading(SubresourceLoader* loader, double)
     if (!m_resource->errorOccurred()) {
         m_cachedResourceLoader->loadFinishing();
         m_resource->data(loader->resourceData(), true);
-        if (!m_resource->errorOccurred())
+        if (!m_resource->errorOccurred()) {
             m_resource->finish();
+            if (m_resource->type() == CachedResource::CSSStyleSheet && m_resource->isPreloaded() && !m_resource->hasClients())
+                m_cachedResourceLoader->preloadImportedStyleSheets(static_cast<CachedCSSStyleSheet*>(m_resource));
+        }
     }
     m_cachedResourceLoader->loadDone(this);
 }
@@ -48,7 +48,9 @@
 #include "HTMLNames.h"
 #include "HTMLPlugInImageElement.h"
 #include "InspectorInstrumentation.h"
+#include "LayoutStatistics.h"
 #include "OverflowEvent.h"
+#include "RenderArena.h"
 #include "RenderEmbeddedObject.h"
 #include "RenderFullScreen.h"
 #include "RenderLayer.h"
@@ -126,6 +128,7 @@ FrameView::FrameView(Frame* frame)
     , m_fixedObjectCount(0)
     , m_layoutTimer(this, &FrameView::layoutTimerFired)
     , m_layoutRoot(0)
+    , m_layoutTrigger(LayoutStatistics::UnknownTrigger)
     , m_hasPendingPostLayoutTasks(false)
     , m_inSynchronousPostLayout(false)
     , m_postLayoutTasksTimer(this, &FrameView::postLayoutTimerFired)
@@ -219,6 +222,7 @@ void FrameView::reset()
     m_borderY = 30;
     m_layoutTimer.stop();
     m_layoutRoot = 0;
+    m_layoutTrigger = LayoutStatistics::UnknownTrigger;
     m_delayedLayout = false;
     m_doFullRepaint = true;
     m_layoutSchedulingEnabled = true;
@@ -808,6 +812,10 @@ void FrameView::layout(bool allowSubtree)
         }
     }
 
+    bool isSynchronous = m_layoutTimer.isActive();
+    LayoutStatistics::Trigger trigger = m_layoutTrigger;
+    m_layoutTrigger = LayoutStatistics::UnknownTrigger;
+
     m_layoutTimer.stop();
     m_delayedLayout = false;
     m_setNeedsLayoutWasDeferred = false;
@@ -829,6 +837,13 @@ void FrameView::layout(bool allowSubtree)
 
     InspectorInstrumentationCookie cookie = InspectorInstrumentation::willLayout(m_frame.get());
 
+    LayoutStatistics statistics;
+#ifdef ANDROID_INSTRUMENT
+    bool collectStatistics = true;
+#else
+    bool collectStatistics = InspectorInstrumentation::collectsLayoutStatistics(cookie);
+#endif
+
     if (!allowSubtree && m_layoutRoot) {
         m_layoutRoot->markContainingBlocksForLayout(false);
         m_layoutRoot = 0;
@@ -971,7 +986,11 @@ void FrameView::layout(bool allowSubtree)
         
     m_inLayout = true;
     beginDeferredRepaints();
+    if (collectStatistics)
+        statistics.start(root, subtree, trigger, isSynchronous);
     root->layout();
+    if (collectStatistics)
+        statistics.stop();
     endDeferredRepaints();
     m_inLayout = false;
 
@@ -1006,6 +1025,11 @@ void FrameView::layout(bool allowSubtree)
     
     m_layoutCount++;
 
+    // Line boxes and other layout-time objects have all been recycled by
+    // now, so this is when whole chunks of the arena may have emptied.
+    if (RenderArena* arena = document->renderArena())
+        arena->trim();
+
 #if PLATFORM(MAC) || PLATFORM(CHROMIUM)
     if (AXObjectCache::accessibilityEnabled())
         root->document()->axObjectCache()->postNotification(root, AXObjectCache::AXLayoutComplete, true);
@@ -1050,7 +1074,7 @@ void FrameView::layout(bool allowSubtree)
         m_actionScheduler->resume();
     }
 
-    InspectorInstrumentation::didLayout(cookie);
+    InspectorInstrumentation::didLayout(cookie, statistics);
 
     m_nestedLayoutCount--;
 #if ENABLE(ANDROID_OVERFLOW_SCROLL)
@@ -1595,6 +1619,7 @@ void FrameView::repaintContentRectangle(const IntRect& r, bool immediate)
 void FrameView::contentsResized()
 {
     scrollAnimator()->contentsResized();
+    LayoutStatistics::TriggerScope triggerScope(LayoutStatistics::ViewportChangeTrigger);
     setNeedsLayout();
 }
 
@@ -1771,6 +1796,8 @@ void FrameView::scheduleRelayout()
         return;
 
     m_delayedLayout = delay != 0;
+    if (m_layoutTrigger == LayoutStatistics::UnknownTrigger)
+        m_layoutTrigger = LayoutStatistics::currentTrigger();
 
 #ifdef INSTRUMENT_LAYOUT_SCHEDULING
     if (!m_frame->document()->ownerElement())
@@ -1823,6 +1850,7 @@ void FrameView::scheduleRelayoutOfSubtree(RenderObject* relayoutRoot)
         m_layoutRoot = relayoutRoot;
         ASSERT(!m_layoutRoot->container() || !m_layoutRoot->container()->needsLayout());
         m_delayedLayout = delay != 0;
+        m_layoutTrigger = LayoutStatistics::currentTrigger();
         m_layoutTimer.startOneShot(delay * 0.001);
     }
 }
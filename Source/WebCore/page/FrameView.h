@@ -27,6 +27,7 @@
 
 #include "Frame.h"
 #include "IntSize.h"
+#include "LayoutStatistics.h"
 #include "Page.h"
 #include "RenderObject.h" // For PaintBehavior
 #include "ScrollView.h"
@@ -376,6 +377,7 @@ private:
     Timer<FrameView> m_layoutTimer;
     bool m_delayedLayout;
     RenderObject* m_layoutRoot;
+    LayoutStatistics::Trigger m_layoutTrigger;
     
     bool m_layoutSchedulingEnabled;
     bool m_inLayout;
@@ -172,6 +172,9 @@ Settings::Settings(Page* page)
     , m_memoryInfoEnabled(false)
     , m_interactiveFormValidation(false)
     , m_usePreHTML5ParserQuirks(false)
+    , m_threadedHTMLTokenizerEnabled(false)
+    , m_parallelSelectorMatchingEnabled(false)
+    , m_parallelLineBreakingEnabled(false)
     , m_hyperlinkAuditingEnabled(false)
     , m_crossOriginCheckInGetMatchedCSSRulesDisabled(false)
     , m_useQuickLookResourceCachingQuirks(false)
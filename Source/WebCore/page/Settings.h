@@ -443,6 +443,21 @@ namespace WebCore {
         void setUsePreHTML5ParserQuirks(bool flag) { m_usePreHTML5ParserQuirks = flag; }
         bool usePreHTML5ParserQuirks() const { return m_usePreHTML5ParserQuirks; }
 
+        // When enabled, network-sourced HTML is tokenized speculatively on a
+        // background thread and the main thread only builds the tree.
+        void setThreadedHTMLTokenizerEnabled(bool flag) { m_threadedHTMLTokenizerEnabled = flag; }
+        bool threadedHTMLTokenizerEnabled() const { return m_threadedHTMLTokenizerEnabled; }
+
+        // When enabled, a forced style recalc matches simple selectors against
+        // the children of large elements on several threads.
+        void setParallelSelectorMatchingEnabled(bool flag) { m_parallelSelectorMatchingEnabled = flag; }
+        bool parallelSelectorMatchingEnabled() const { return m_parallelSelectorMatchingEnabled; }
+
+        // When enabled, a block about to lay out many paragraphs finds their
+        // line break opportunities on several threads.
+        void setParallelLineBreakingEnabled(bool flag) { m_parallelLineBreakingEnabled = flag; }
+        bool parallelLineBreakingEnabled() const { return m_parallelLineBreakingEnabled; }
+
         void setHyperlinkAuditingEnabled(bool flag) { m_hyperlinkAuditingEnabled = flag; }
         bool hyperlinkAuditingEnabled() const { return m_hyperlinkAuditingEnabled; }
 
@@ -583,6 +598,9 @@ namespace WebCore {
         bool m_memoryInfoEnabled: 1;
         bool m_interactiveFormValidation: 1;
         bool m_usePreHTML5ParserQuirks: 1;
+        bool m_threadedHTMLTokenizerEnabled : 1;
+        bool m_parallelSelectorMatchingEnabled : 1;
+        bool m_parallelLineBreakingEnabled : 1;
         bool m_hyperlinkAuditingEnabled : 1;
         bool m_crossOriginCheckInGetMatchedCSSRulesDisabled : 1;
         bool m_useQuickLookResourceCachingQuirks : 1;
@@ -0,0 +1,108 @@
+/*
+ * Copyright 2011, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "ParallelWorkerPool.h"
+
+namespace WebCore {
+
+ParallelWorkerPool::ParallelWorkerPool(const char* threadName, size_t maximumWorkerCount)
+    : m_threadName(threadName)
+    , m_maximumWorkerCount(maximumWorkerCount)
+    , m_workerCount(0)
+    , m_function(0)
+    , m_jobs(0)
+    , m_jobSize(0)
+    , m_jobCount(0)
+    , m_nextJob(0)
+    , m_unfinishedJobCount(0)
+{
+}
+
+void ParallelWorkerPool::run(JobFunction function, void* jobs, size_t jobSize, size_t jobCount)
+{
+    if (!jobCount)
+        return;
+
+    MutexLocker locker(m_mutex);
+    ASSERT(!m_unfinishedJobCount);
+
+    // One job is left for the calling thread.
+    while (m_workerCount + 1 < jobCount && m_workerCount < m_maximumWorkerCount) {
+        ThreadIdentifier thread = createThread(workerThreadStart, this, m_threadName);
+        if (!thread)
+            break;
+        detachThread(thread);
+        ++m_workerCount;
+    }
+
+    m_function = function;
+    m_jobs = static_cast<char*>(jobs);
+    m_jobSize = jobSize;
+    m_jobCount = jobCount;
+    m_nextJob = 0;
+    m_unfinishedJobCount = jobCount;
+    m_jobsAvailable.broadcast();
+
+    runAvailableJobs();
+    while (m_unfinishedJobCount)
+        m_jobsDone.wait(m_mutex);
+
+    m_function = 0;
+    m_jobs = 0;
+    m_jobCount = 0;
+    m_nextJob = 0;
+}
+
+void ParallelWorkerPool::runAvailableJobs()
+{
+    while (m_nextJob < m_jobCount) {
+        void* job = m_jobs + m_nextJob++ * m_jobSize;
+        JobFunction function = m_function;
+        m_mutex.unlock();
+        function(job);
+        m_mutex.lock();
+        if (!--m_unfinishedJobCount)
+            m_jobsDone.signal();
+    }
+}
+
+void* ParallelWorkerPool::workerThreadStart(void* context)
+{
+    static_cast<ParallelWorkerPool*>(context)->workerLoop();
+    return 0;
+}
+
+void ParallelWorkerPool::workerLoop()
+{
+    MutexLocker locker(m_mutex);
+    while (true) {
+        while (m_nextJob >= m_jobCount)
+            m_jobsAvailable.wait(m_mutex);
+        runAvailableJobs();
+    }
+}
+
+} // namespace WebCore
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2011, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ParallelWorkerPool_h
+#define ParallelWorkerPool_h
+
+#include <wtf/FastAllocBase.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/Threading.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+// A set of worker threads that run short batches of jobs for one thread at
+// a time, typically the main thread. The workers are started the first time
+// a batch needs them and then wait for the next batch, so callers do not pay
+// for thread creation on every batch. Pools are meant to live for the rest
+// of the process.
+class ParallelWorkerPool {
+    WTF_MAKE_NONCOPYABLE(ParallelWorkerPool); WTF_MAKE_FAST_ALLOCATED;
+public:
+    typedef void (*JobFunction)(void* job);
+
+    ParallelWorkerPool(const char* threadName, size_t maximumWorkerCount);
+
+    // Calls the function on every job and returns once all of them are done.
+    // The calling thread runs jobs as well, so the batch completes even if
+    // no worker could be started.
+    void run(JobFunction, void* jobs, size_t jobSize, size_t jobCount);
+
+    template <typename Job, size_t inlineCapacity>
+    void run(JobFunction function, Vector<Job, inlineCapacity>& jobs)
+    {
+        run(function, jobs.data(), sizeof(Job), jobs.size());
+    }
+
+private:
+    static void* workerThreadStart(void*);
+    void workerLoop();
+    // Runs jobs of the current batch until there are none left to start.
+    // Called with m_mutex held, which is released while a job runs.
+    void runAvailableJobs();
+
+    const char* m_threadName;
+    size_t m_maximumWorkerCount;
+    size_t m_workerCount;
+
+    Mutex m_mutex;
+    ThreadCondition m_jobsAvailable;
+    ThreadCondition m_jobsDone;
+    JobFunction m_function;
+    char* m_jobs;
+    size_t m_jobSize;
+    size_t m_jobCount;
+    size_t m_nextJob;
+    size_t m_unfinishedJobCount;
+};
+
+} // namespace WebCore
+
+#endif // ParallelWorkerPool_h
@@ -177,12 +177,33 @@ float Font::width(const TextRun& run, HashSet<const SimpleFontData*>* fallbackFo
         // If the complex text implementation cannot return fallback fonts, avoid
         // returning them for simple text as well.
         static bool returnFallbackFonts = canReturnFallbackFontsForComplexText();
-        return floatWidthForSimpleText(run, 0, returnFallbackFonts ? fallbackFonts : 0, codePathToUse == SimpleWithGlyphOverflow || (glyphOverflow && glyphOverflow->computeBounds) ? glyphOverflow : 0);
+        if (!returnFallbackFonts)
+            fallbackFonts = 0;
+        if (codePathToUse == SimpleWithGlyphOverflow || (glyphOverflow && glyphOverflow->computeBounds))
+            return floatWidthForSimpleText(run, 0, fallbackFonts, glyphOverflow);
+        if (fallbackFonts || !canUseWidthCache(run))
+            return floatWidthForSimpleText(run, 0, fallbackFonts);
+
+        bool isNewEntry;
+        float* cachedWidth = m_fontList->widthCache().add(run.characters(), run.length(), isNewEntry);
+        if (isNewEntry)
+            *cachedWidth = floatWidthForSimpleText(run, 0);
+        return *cachedWidth;
     }
 
     return floatWidthForComplexText(run, fallbackFonts, glyphOverflow);
 }
 
+// The width cache is keyed by the characters alone, so it only holds runs
+// whose width does not also depend on their position, justification,
+// direction or spacing.
+bool Font::canUseWidthCache(const TextRun& run) const
+{
+    return run.length() && static_cast<unsigned>(run.length()) <= WidthCache::maxRunLength
+        && !run.allowTabs() && !run.expansion() && run.ltr() && run.horizontalGlyphStretch() == 1
+        && !m_letterSpacing && !m_wordSpacing && !loadingCustomFonts();
+}
+
 float Font::width(const TextRun& run, int extraCharsAvailable, int& charsConsumed, String& glyphName) const
 {
 #if !ENABLE(SVG_FONTS)
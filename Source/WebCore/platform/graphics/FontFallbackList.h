@@ -23,7 +23,9 @@
 
 #include "FontSelector.h"
 #include "SimpleFontData.h"
+#include "WidthCache.h"
 #include <wtf/Forward.h>
+#include <wtf/OwnArrayPtr.h>
 
 namespace WebCore {
 
@@ -70,10 +72,35 @@ private:
 
     void releaseFontData();
 
+    WidthCache& widthCache() const { return m_widthCache; }
+
+    // Latin-1 characters make up most of the text on most pages, so their
+    // glyphs are kept in a flat table instead of being looked up in the
+    // glyph page tree every time.
+    static const UChar32 latin1GlyphCount = 256;
+
+    const GlyphData* cachedLatin1GlyphData(UChar32 c) const
+    {
+        ASSERT(c < latin1GlyphCount);
+        if (!m_latin1GlyphData || !m_latin1GlyphData[c].fontData)
+            return 0;
+        return &m_latin1GlyphData[c];
+    }
+
+    void cacheLatin1GlyphData(UChar32 c, const GlyphData& data) const
+    {
+        ASSERT(c < latin1GlyphCount);
+        if (!m_latin1GlyphData)
+            m_latin1GlyphData = adoptArrayPtr(new GlyphData[latin1GlyphCount]);
+        m_latin1GlyphData[c] = data;
+    }
+
     mutable Vector<pair<const FontData*, bool>, 1> m_fontList;
     mutable HashMap<int, GlyphPageTreeNode*> m_pages;
     mutable GlyphPageTreeNode* m_pageZero;
     mutable const SimpleFontData* m_cachedPrimarySimpleFontData;
+    mutable WidthCache m_widthCache;
+    mutable OwnArrayPtr<GlyphData> m_latin1GlyphData;
     RefPtr<FontSelector> m_fontSelector;
     mutable int m_familyIndex;
     mutable Pitch m_pitch;
@@ -59,6 +59,11 @@ GlyphData Font::glyphDataForCharacter(UChar32 c, bool mirror, FontDataVariant va
     if (mirror)
         c = mirroredChar(c);
 
+    if (c < FontFallbackList::latin1GlyphCount && variant == NormalVariant) {
+        if (const GlyphData* data = m_fontList->cachedLatin1GlyphData(c))
+            return *data;
+    }
+
     unsigned pageNumber = (c / GlyphPage::size);
 
     GlyphPageTreeNode* node = pageNumber ? m_fontList->m_pages.get(pageNumber) : m_fontList->m_pageZero;
@@ -77,8 +82,13 @@ GlyphData Font::glyphDataForCharacter(UChar32 c, bool mirror, FontDataVariant va
             page = node->page();
             if (page) {
                 GlyphData data = page->glyphDataForCharacter(c);
-                if (data.fontData && (data.fontData->platformData().orientation() == Horizontal || data.fontData->isTextOrientationFallback()))
+                if (data.fontData && (data.fontData->platformData().orientation() == Horizontal || data.fontData->isTextOrientationFallback())) {
+                    // Only the fonts in the fallback list itself are known to
+                    // outlive it; system fallback fonts may be purged.
+                    if (c < FontFallbackList::latin1GlyphCount && !node->isSystemFallback())
+                        m_fontList->cacheLatin1GlyphData(c, data);
                     return data;
+                }
                 
                 if (data.fontData) {
                     if (isCJKIdeographOrSymbol(c)) {
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2011, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef WidthCache_h
+#define WidthCache_h
+
+#include <wtf/HashMap.h>
+#include <wtf/HashTraits.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/StringHasher.h>
+#include <wtf/unicode/Unicode.h>
+
+namespace WebCore {
+
+// Remembers the widths of short runs of simple text measured with one
+// font. Line layout measures every word of a paragraph each time the
+// paragraph is laid out, and the same words recur throughout a page.
+class WidthCache {
+    WTF_MAKE_NONCOPYABLE(WidthCache);
+public:
+    static const unsigned maxRunLength = 16;
+
+    WidthCache() { }
+
+    // Returns the slot for the width of the given characters. A new slot
+    // holds no width yet and the caller must fill it in before the cache
+    // is used again.
+    float* add(const UChar* characters, unsigned length, bool& isNewEntry)
+    {
+        ASSERT(length && length <= maxRunLength);
+        if (static_cast<unsigned>(m_widths.size()) >= maxEntryCount)
+            m_widths.clear();
+        std::pair<WidthMap::iterator, bool> result = m_widths.add(Key(characters, length), 0);
+        isNewEntry = result.second;
+#ifdef ANDROID_INSTRUMENT
+        if (isNewEntry)
+            ++s_missCount;
+        else
+            ++s_hitCount;
+#endif
+        return &result.first->second;
+    }
+
+    void clear() { m_widths.clear(); }
+
+#ifdef ANDROID_INSTRUMENT
+    static unsigned hitCount() { return s_hitCount; }
+    static unsigned missCount() { return s_missCount; }
+#endif
+
+private:
+    // Enough for the distinct words of a long article in one font, while
+    // keeping a font's cache to a few kilobytes.
+    static const unsigned maxEntryCount = 512;
+
+    class Key {
+    public:
+        Key()
+            : m_length(0)
+            , m_hash(0)
+        {
+        }
+
+        Key(WTF::HashTableDeletedValueType)
+            : m_length(maxRunLength + 1)
+            , m_hash(0)
+        {
+        }
+
+        Key(const UChar* characters, unsigned length)
+            : m_length(length)
+            , m_hash(StringHasher::computeHash(characters, length))
+        {
+            memcpy(m_characters, characters, length * sizeof(UChar));
+        }
+
+        bool isHashTableDeletedValue() const { return m_length == maxRunLength + 1; }
+        unsigned hash() const { return m_hash; }
+
+        bool operator==(const Key& other) const
+        {
+            return m_hash == other.m_hash && m_length == other.m_length
+                && !memcmp(m_characters, other.m_characters, m_length * sizeof(UChar));
+        }
+
+    private:
+        unsigned m_length;
+        unsigned m_hash;
+        UChar m_characters[maxRunLength];
+    };
+
+    struct KeyHash {
+        static unsigned hash(const Key& key) { return key.hash(); }
+        static bool equal(const Key& a, const Key& b) { return a == b; }
+        static const bool safeToCompareToEmptyOrDeleted = true;
+    };
+
+    typedef HashMap<Key, float, KeyHash, WTF::SimpleClassHashTraits<Key> > WidthMap;
+    WidthMap m_widths;
+
+#ifdef ANDROID_INSTRUMENT
+    static unsigned s_hitCount;
+    static unsigned s_missCount;
+#endif
+};
+
+} // namespace WebCore
+
+#endif // WidthCache_h
@@ -48,10 +48,14 @@
 #include "HarfbuzzSkia.h"
 #include <unicode/normlzr.h>
 #include <unicode/uchar.h>
+#include <wtf/HashMap.h>
 #include <wtf/OwnArrayPtr.h>
 #include <wtf/OwnPtr.h>
 #include <wtf/PassOwnArrayPtr.h>
 #include <wtf/PassOwnPtr.h>
+#include <wtf/StdLibExtras.h>
+#include <wtf/StringHasher.h>
+#include <wtf/Vector.h>
 #include <wtf/unicode/Unicode.h>
 #endif
 
@@ -363,6 +367,169 @@ static int truncateFixedPointToInteger(HB_Fixed value)
     return value >> 6;
 }
 
+// ShapeResultCache remembers the glyphs, advances and cluster logs that
+// Harfbuzz produced for recently shaped script runs. A run of text is
+// measured several times during line layout and shaped again every time it
+// is painted, and shaping complex scripts costs far more than copying the
+// result back. Word and letter spacing and justification are applied after
+// shaping, so they are not part of the key. Neither is the text around the
+// run, so runs whose shaping looks at it are not cached.
+class ShapeResultCache {
+    WTF_MAKE_NONCOPYABLE(ShapeResultCache);
+public:
+    class Key {
+    public:
+        Key()
+            : m_script(0)
+            , m_bidiLevel(0)
+            , m_hash(0)
+        {
+        }
+
+        Key(WTF::HashTableDeletedValueType)
+            : m_text(WTF::HashTableDeletedValue)
+            , m_script(0)
+            , m_bidiLevel(0)
+            , m_hash(0)
+        {
+        }
+
+        Key(const UChar* characters, unsigned length, const FontPlatformData& platformData, int script, int bidiLevel)
+            : m_text(characters, length)
+            , m_platformData(platformData)
+            , m_script(script)
+            , m_bidiLevel(bidiLevel)
+        {
+            m_hash = StringHasher::computeHash(characters, length) ^ platformData.hash()
+                ^ WTF::intHash(static_cast<uint32_t>((script << 8) | bidiLevel));
+        }
+
+        bool isHashTableDeletedValue() const { return m_text.isHashTableDeletedValue(); }
+        unsigned hash() const { return m_hash; }
+        unsigned length() const { return m_text.length(); }
+
+        bool operator==(const Key& other) const
+        {
+            return m_hash == other.m_hash && m_script == other.m_script && m_bidiLevel == other.m_bidiLevel
+                && m_text == other.m_text && m_platformData == other.m_platformData;
+        }
+
+    private:
+        String m_text;
+        FontPlatformData m_platformData;
+        int m_script;
+        int m_bidiLevel;
+        unsigned m_hash;
+    };
+
+    struct Result {
+        Key key;
+        Vector<HB_Glyph> glyphs;
+        Vector<HB_Fixed> advances;
+        Vector<unsigned short> logClusters;
+        Result* previous;
+        Result* next;
+    };
+
+    ShapeResultCache()
+        : m_mostRecent(0)
+        , m_leastRecent(0)
+        , m_characterCount(0)
+    {
+    }
+
+    // Runs longer than this are rarely shaped twice in the same way.
+    static const unsigned maxRunLength = 512;
+
+    const Result* get(const Key&);
+    void add(const Key&, const HB_ShaperItem&);
+
+private:
+    // Bounds the cache to a few hundred kilobytes.
+    static const unsigned maxResultCount = 512;
+    static const unsigned maxCharacterCount = 32 * 1024;
+
+    void link(Result*);
+    void unlink(Result*);
+
+    struct KeyHash {
+        static unsigned hash(const Key& key) { return key.hash(); }
+        static bool equal(const Key& a, const Key& b) { return a == b; }
+        static const bool safeToCompareToEmptyOrDeleted = false;
+    };
+
+    struct KeyTraits : WTF::SimpleClassHashTraits<Key> {
+        static const bool emptyValueIsZero = false;
+    };
+
+    typedef HashMap<Key, Result*, KeyHash, KeyTraits> ResultMap;
+    ResultMap m_results;
+    Result* m_mostRecent;
+    Result* m_leastRecent;
+    unsigned m_characterCount;
+};
+
+static ShapeResultCache& shapeResultCache()
+{
+    DEFINE_STATIC_LOCAL(ShapeResultCache, cache, ());
+    return cache;
+}
+
+void ShapeResultCache::link(Result* result)
+{
+    result->previous = 0;
+    result->next = m_mostRecent;
+    if (m_mostRecent)
+        m_mostRecent->previous = result;
+    else
+        m_leastRecent = result;
+    m_mostRecent = result;
+}
+
+void ShapeResultCache::unlink(Result* result)
+{
+    if (result->previous)
+        result->previous->next = result->next;
+    else
+        m_mostRecent = result->next;
+    if (result->next)
+        result->next->previous = result->previous;
+    else
+        m_leastRecent = result->previous;
+}
+
+const ShapeResultCache::Result* ShapeResultCache::get(const Key& key)
+{
+    Result* result = m_results.get(key);
+    if (result && result != m_mostRecent) {
+        unlink(result);
+        link(result);
+    }
+    return result;
+}
+
+void ShapeResultCache::add(const Key& key, const HB_ShaperItem& item)
+{
+    ASSERT(key.length() <= maxRunLength);
+    while (m_leastRecent && (static_cast<unsigned>(m_results.size()) >= maxResultCount
+        || m_characterCount + key.length() > maxCharacterCount)) {
+        Result* evicted = m_leastRecent;
+        unlink(evicted);
+        m_results.remove(evicted->key);
+        m_characterCount -= evicted->key.length();
+        delete evicted;
+    }
+
+    Result* result = new Result;
+    result->key = key;
+    result->glyphs.append(item.glyphs, item.num_glyphs);
+    result->advances.append(item.advances, item.num_glyphs);
+    result->logClusters.append(item.log_clusters, item.item.length);
+    link(result);
+    m_results.set(key, result);
+    m_characterCount += key.length();
+}
+
 // TextRunWalker walks a TextRun and presents each script run in sequence. A
 // TextRun is a sequence of code-points with the same embedding level (i.e. they
 // are all left-to-right or right-to-left). A script run is a subsequence where
@@ -793,8 +960,37 @@ void TextRunWalker::resetGlyphArrays()
     memset(m_xPositions, 0, size * sizeof(m_xPositions[0]));
 }
 
+// The Arabic shaper, which Syriac shares, picks joining forms from the
+// characters on either side of the run as well as those inside it.
+static bool shapingDependsOnContext(const HB_ShaperItem& item)
+{
+    if (item.item.script != HB_Script_Arabic && item.item.script != HB_Script_Syriac)
+        return false;
+    return item.item.pos || item.item.pos + item.item.length < item.stringLength;
+}
+
 void TextRunWalker::shapeGlyphs()
 {
+    bool isCacheable = m_item.item.length <= ShapeResultCache::maxRunLength && !shapingDependsOnContext(m_item);
+    ShapeResultCache::Key key;
+    if (isCacheable) {
+        key = ShapeResultCache::Key(m_item.string + m_item.item.pos, m_item.item.length,
+            *fontPlatformDataForScriptRun(), m_item.item.script, m_item.item.bidiLevel);
+        if (const ShapeResultCache::Result* result = shapeResultCache().get(key)) {
+            unsigned numGlyphs = result->glyphs.size();
+            if (numGlyphs > m_glyphsArrayCapacity) {
+                deleteGlyphArrays();
+                createGlyphArrays(numGlyphs);
+            }
+            m_item.num_glyphs = numGlyphs;
+            resetGlyphArrays();
+            memcpy(m_item.glyphs, result->glyphs.data(), numGlyphs * sizeof(m_item.glyphs[0]));
+            memcpy(m_item.advances, result->advances.data(), numGlyphs * sizeof(m_item.advances[0]));
+            memcpy(m_item.log_clusters, result->logClusters.data(), m_item.item.length * sizeof(m_item.log_clusters[0]));
+            return;
+        }
+    }
+
     // HB_ShapeItem() resets m_item.num_glyphs. If the previous call to
     // HB_ShapeItem() used less space than was available, the capacity of
     // the array may be larger than the current value of m_item.num_glyphs.
@@ -808,6 +1004,9 @@ void TextRunWalker::shapeGlyphs()
         createGlyphArrays(m_item.num_glyphs << 1);
         resetGlyphArrays();
     }
+
+    if (isCacheable)
+        shapeResultCache().add(key, m_item);
 }
 
 void TextRunWalker::setGlyphXPositions(bool isRTL)
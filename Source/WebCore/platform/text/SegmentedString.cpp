@@ -206,6 +206,13 @@ void SegmentedString::advance(unsigned count, UChar* consumedCharacters)
     }
 }
 
+void SegmentedString::advance(unsigned count, int& lineNumber)
+{
+    ASSERT(count <= length());
+    for (unsigned i = 0; i < count; ++i)
+        advance(lineNumber);
+}
+
 void SegmentedString::advanceSlowCase()
 {
     if (m_pushedChar1) {
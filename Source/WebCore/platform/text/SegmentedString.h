@@ -201,9 +201,33 @@ public:
         advanceSlowCase(lineNumber);
     }
 
+    // The characters after the current one that can be read in place,
+    // without crossing into the next substring or passing a pushed
+    // character. Lets callers scan runs of input in bulk and then consume
+    // them with advancePastNonNewlines().
+    const UChar* charactersAfterCurrent(unsigned& length) const
+    {
+        if (m_pushedChar1 || !m_currentString.m_length) {
+            length = 0;
+            return 0;
+        }
+        length = m_currentString.m_length - 1;
+        return m_currentString.m_current + 1;
+    }
+
+    void advancePastNonNewlines(unsigned count)
+    {
+        ASSERT(!m_pushedChar1);
+        ASSERT(count < static_cast<unsigned>(m_currentString.m_length));
+        m_currentString.m_length -= count;
+        m_currentString.m_current += count;
+        m_currentChar = m_currentString.m_current;
+    }
+
     // Writes the consumed characters into consumedCharacters, which must
     // have space for at least |count| characters.
     void advance(unsigned count, UChar* consumedCharacters);
+    void advance(unsigned count, int& lineNumber);
 
     bool escaped() const { return m_pushedChar1; }
 
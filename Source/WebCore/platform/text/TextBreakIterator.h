@@ -45,6 +45,15 @@ namespace WebCore {
     TextBreakIterator* wordBreakIterator(const UChar*, int length);
     TextBreakIterator* acquireLineBreakIterator(const UChar*, int length);
     void releaseLineBreakIterator(TextBreakIterator*);
+#if USE(ICU_UNICODE)
+    // Unlike the iterators above, these are not shared, so they can be used
+    // on any thread.
+    TextBreakIterator* openLineBreakIterator(const UChar*, int length);
+    // Points an iterator from openLineBreakIterator() at another string,
+    // which is much cheaper than opening a new one.
+    bool setLineBreakIteratorText(TextBreakIterator*, const UChar*, int length);
+    void closeLineBreakIterator(TextBreakIterator*);
+#endif
     TextBreakIterator* sentenceBreakIterator(const UChar*, int length);
 
     int textBreakFirst(TextBreakIterator*);
@@ -100,6 +100,31 @@ void releaseLineBreakIterator(TextBreakIterator* iterator)
         ubrk_close(reinterpret_cast<UBreakIterator*>(iterator));
 }
 
+TextBreakIterator* openLineBreakIterator(const UChar* string, int length)
+{
+    bool createdIterator = false;
+    TextBreakIterator* iterator = 0;
+    if (!setUpIterator(createdIterator, iterator, UBRK_LINE, string, length)) {
+        if (iterator)
+            ubrk_close(reinterpret_cast<UBreakIterator*>(iterator));
+        return 0;
+    }
+    return iterator;
+}
+
+bool setLineBreakIteratorText(TextBreakIterator* iterator, const UChar* string, int length)
+{
+    ASSERT(iterator);
+    bool createdIterator = true;
+    return setUpIterator(createdIterator, iterator, UBRK_LINE, string, length);
+}
+
+void closeLineBreakIterator(TextBreakIterator* iterator)
+{
+    ASSERT(iterator);
+    ubrk_close(reinterpret_cast<UBreakIterator*>(iterator));
+}
+
 TextBreakIterator* sentenceBreakIterator(const UChar* string, int length)
 {
     static bool createdSentenceBreakIterator = false;
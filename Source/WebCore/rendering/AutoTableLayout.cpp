@@ -35,6 +35,8 @@ AutoTableLayout::AutoTableLayout(RenderTable* table)
     : TableLayout(table)
     , m_hasPercent(false)
     , m_effectiveLogicalWidthDirty(true)
+    , m_needsFullRecalc(true)
+    , m_hasDirtyColumns(false)
 {
 }
 
@@ -105,6 +107,7 @@ void AutoTableLayout::recalcColumn(int effCol)
                         break;
                     case Percent:
                         m_hasPercent = true;
+                        columnLayout.hasPercentCell = true;
                         if (cellLogicalWidth.isPositive() && (!columnLayout.logicalWidth.isPercent() || cellLogicalWidth.value() > columnLayout.logicalWidth.value()))
                             columnLayout.logicalWidth = cellLogicalWidth;
                         break;
@@ -142,6 +145,8 @@ void AutoTableLayout::fullRecalc()
 {
     m_hasPercent = false;
     m_effectiveLogicalWidthDirty = true;
+    m_needsFullRecalc = false;
+    m_hasDirtyColumns = false;
 
     int nEffCols = m_table->numEffCols();
     m_layoutStruct.resize(nEffCols);
@@ -185,6 +190,61 @@ void AutoTableLayout::fullRecalc()
         recalcColumn(i);
 }
 
+void AutoTableLayout::cellPreferredLogicalWidthsDirtied(RenderTableCell* cell)
+{
+    if (m_needsFullRecalc || m_table->needsSectionRecalc())
+        return;
+
+    size_t effCol = m_table->colToEffCol(cell->col());
+    if (effCol >= m_layoutStruct.size()) {
+        m_needsFullRecalc = true;
+        return;
+    }
+    m_layoutStruct[effCol].needsRecalc = true;
+    m_hasDirtyColumns = true;
+}
+
+bool AutoTableLayout::canRecalcDirtyColumns() const
+{
+    // <col> widths reach the cells through styleOrColLogicalWidth(), and
+    // collapsed borders depend on the neighbouring cells, so neither is
+    // tracked per column.
+    return !m_needsFullRecalc && !m_table->hasColElements() && !m_table->collapseBorders()
+        && static_cast<size_t>(m_table->numEffCols()) == m_layoutStruct.size();
+}
+
+void AutoTableLayout::recalcDirtyColumns()
+{
+    if (!m_hasDirtyColumns)
+        return;
+
+    // Drop the spanning cells that start in a dirty column, recalcColumn()
+    // adds them back. The rest stay sorted by span.
+    size_t keptSpanCells = 0;
+    for (size_t i = 0; i < m_spanCells.size(); ++i) {
+        RenderTableCell* cell = m_spanCells[i];
+        if (!cell)
+            break;
+        if (!m_layoutStruct[m_table->colToEffCol(cell->col())].needsRecalc)
+            m_spanCells[keptSpanCells++] = cell;
+    }
+    for (size_t i = keptSpanCells; i < m_spanCells.size() && m_spanCells[i]; ++i)
+        m_spanCells[i] = 0;
+
+    m_hasPercent = false;
+    for (size_t i = 0; i < m_layoutStruct.size(); ++i) {
+        if (m_layoutStruct[i].needsRecalc) {
+            m_layoutStruct[i] = Layout();
+            recalcColumn(i);
+        }
+        if (m_layoutStruct[i].hasPercentCell)
+            m_hasPercent = true;
+    }
+
+    m_effectiveLogicalWidthDirty = true;
+    m_hasDirtyColumns = false;
+}
+
 // FIXME: This needs to be adapted for vertical writing modes.
 static bool shouldScaleColumns(RenderTable* table)
 {
@@ -221,7 +281,10 @@ static bool shouldScaleColumns(RenderTable* table)
 
 void AutoTableLayout::computePreferredLogicalWidths(int& minWidth, int& maxWidth)
 {
-    fullRecalc();
+    if (canRecalcDirtyColumns())
+        recalcDirtyColumns();
+    else
+        fullRecalc();
 
     int spanMaxLogicalWidth = calcEffectiveLogicalWidth();
     minWidth = 0;
@@ -286,6 +349,7 @@ int AutoTableLayout::calcEffectiveLogicalWidth()
         m_layoutStruct[i].effectiveLogicalWidth = m_layoutStruct[i].logicalWidth;
         m_layoutStruct[i].effectiveMinLogicalWidth = m_layoutStruct[i].minLogicalWidth;
         m_layoutStruct[i].effectiveMaxLogicalWidth = m_layoutStruct[i].maxLogicalWidth;
+        m_layoutStruct[i].effectiveEmptyCellsOnly = m_layoutStruct[i].emptyCellsOnly;
     }
 
     for (size_t i = 0; i < m_spanCells.size(); ++i) {
@@ -345,7 +409,7 @@ int AutoTableLayout::calcEffectiveLogicalWidth()
                     totalPercent += columnLayout.effectiveLogicalWidth.percent();
                 allColsAreFixed = false;
             }
-            if (!columnLayout.emptyCellsOnly)
+            if (!columnLayout.effectiveEmptyCellsOnly)
                 spanHasEmptyCellsOnly = false;
             span -= m_table->spanOfEffCol(lastCol);
             spanMinLogicalWidth += columnLayout.effectiveMinLogicalWidth;
@@ -438,7 +502,7 @@ int AutoTableLayout::calcEffectiveLogicalWidth()
         // treat span ranges consisting of empty cells only as if they had content
         if (spanHasEmptyCellsOnly) {
             for (unsigned pos = effCol; pos < lastCol; ++pos)
-                m_layoutStruct[pos].emptyCellsOnly = false;
+                m_layoutStruct[pos].effectiveEmptyCellsOnly = false;
         }
     }
     m_effectiveLogicalWidthDirty = false;
@@ -522,7 +586,7 @@ void AutoTableLayout::layout()
             // fall through
             break;
         case Auto:
-            if (m_layoutStruct[i].emptyCellsOnly)
+            if (m_layoutStruct[i].effectiveEmptyCellsOnly)
                 numAutoEmptyCellsOnly++;
             else {
                 numAuto++;
@@ -591,7 +655,7 @@ void AutoTableLayout::layout()
         available += allocAuto; // this gets redistributed
         for (size_t i = 0; i < nEffCols; ++i) {
             Length& logicalWidth = m_layoutStruct[i].effectiveLogicalWidth;
-            if (logicalWidth.isAuto() && totalAuto && !m_layoutStruct[i].emptyCellsOnly) {
+            if (logicalWidth.isAuto() && totalAuto && !m_layoutStruct[i].effectiveEmptyCellsOnly) {
                 int cellLogicalWidth = max(m_layoutStruct[i].computedLogicalWidth, static_cast<int>(available * static_cast<float>(m_layoutStruct[i].effectiveMaxLogicalWidth) / totalAuto));
                 available -= cellLogicalWidth;
                 totalAuto -= m_layoutStruct[i].effectiveMaxLogicalWidth;
@@ -634,7 +698,7 @@ void AutoTableLayout::layout()
         // still have some width to spread
         for (int i = nEffCols - 1; i >= 0; --i) {
             // variable columns with empty cells only don't get any width
-            if (m_layoutStruct[i].effectiveLogicalWidth.isAuto() && m_layoutStruct[i].emptyCellsOnly)
+            if (m_layoutStruct[i].effectiveLogicalWidth.isAuto() && m_layoutStruct[i].effectiveEmptyCellsOnly)
                 continue;
             int cellLogicalWidth = available / total;
             available -= cellLogicalWidth;
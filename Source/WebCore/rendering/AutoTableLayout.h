@@ -38,8 +38,13 @@ public:
     virtual void computePreferredLogicalWidths(int& minWidth, int& maxWidth);
     virtual void layout();
 
+    virtual void cellPreferredLogicalWidthsDirtied(RenderTableCell*);
+    virtual void cellGridChanged() { m_needsFullRecalc = true; }
+
 private:
     void fullRecalc();
+    bool canRecalcDirtyColumns() const;
+    void recalcDirtyColumns();
     void recalcColumn(int effCol);
 
     int calcEffectiveLogicalWidth();
@@ -54,6 +59,9 @@ private:
             , effectiveMaxLogicalWidth(0)
             , computedLogicalWidth(0)
             , emptyCellsOnly(true)
+            , effectiveEmptyCellsOnly(true)
+            , hasPercentCell(false)
+            , needsRecalc(false)
         {
         }
 
@@ -65,12 +73,22 @@ private:
         int effectiveMaxLogicalWidth;
         int computedLogicalWidth;
         bool emptyCellsOnly;
+        // emptyCellsOnly, cleared for spans of empty cells. Rebuilt by
+        // calcEffectiveLogicalWidth() so that it never outlives the spans.
+        bool effectiveEmptyCellsOnly;
+        bool hasPercentCell;
+        bool needsRecalc;
     };
 
     Vector<Layout, 4> m_layoutStruct;
     Vector<RenderTableCell*, 4> m_spanCells;
     bool m_hasPercent : 1;
     mutable bool m_effectiveLogicalWidthDirty : 1;
+
+    // Until the next full recalc, the columns of the cells whose widths
+    // changed are marked needsRecalc, and only those are recomputed.
+    bool m_needsFullRecalc : 1;
+    bool m_hasDirtyColumns : 1;
 };
 
 } // namespace WebCore
@@ -0,0 +1,130 @@
+/*
+ * Copyright 2011, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "LayoutStatistics.h"
+
+#include "RenderObject.h"
+#include <wtf/CurrentTime.h>
+
+namespace WebCore {
+
+LayoutStatistics* LayoutStatistics::s_current = 0;
+LayoutStatistics::Trigger LayoutStatistics::s_currentTrigger = LayoutStatistics::UnknownTrigger;
+#ifdef ANDROID_INSTRUMENT
+LayoutStatistics::Totals LayoutStatistics::s_totals;
+#endif
+
+const char* LayoutStatistics::triggerName(Trigger trigger)
+{
+    switch (trigger) {
+    case UnknownTrigger:
+        return "Unknown";
+    case StyleChangeTrigger:
+        return "StyleChange";
+    case RenderTreeChangeTrigger:
+        return "RenderTreeChange";
+    case TextChangeTrigger:
+        return "TextChange";
+    case ResourceLoadTrigger:
+        return "ResourceLoad";
+    case ViewportChangeTrigger:
+        return "ViewportChange";
+    case TriggerCount:
+        break;
+    }
+    ASSERT_NOT_REACHED();
+    return "";
+}
+
+LayoutStatistics::LayoutStatistics()
+    : m_previous(0)
+    , m_wasCollected(false)
+    , m_rootName("")
+    , m_isSubtree(false)
+    , m_trigger(UnknownTrigger)
+    , m_isSynchronous(false)
+    , m_objectCount(0)
+    , m_selfNeedsLayoutCount(0)
+    , m_lineCount(0)
+    , m_inlineBoxCount(0)
+    , m_startTime(0)
+    , m_totalTime(0)
+{
+    for (unsigned i = 0; i < PhaseCount; ++i) {
+        m_phaseDepth[i] = 0;
+        m_phaseStartTime[i] = 0;
+        m_phaseTime[i] = 0;
+    }
+}
+
+void LayoutStatistics::start(RenderObject* root, bool isSubtree, Trigger trigger, bool isSynchronous)
+{
+    ASSERT(!m_wasCollected);
+    m_rootName = root->renderName();
+    m_isSubtree = isSubtree;
+    m_trigger = trigger;
+    m_isSynchronous = isSynchronous;
+
+    // Layout of a subframe nested in this pass reports to its own instance.
+    m_previous = s_current;
+    s_current = this;
+    m_startTime = currentTime();
+}
+
+void LayoutStatistics::stop()
+{
+    ASSERT(s_current == this);
+    m_totalTime = currentTime() - m_startTime;
+    s_current = m_previous;
+    m_previous = 0;
+    m_wasCollected = true;
+
+#ifdef ANDROID_INSTRUMENT
+    ++s_totals.passCount;
+    if (m_isSynchronous)
+        ++s_totals.synchronousPassCount;
+    ++s_totals.passCountByTrigger[m_trigger];
+    s_totals.objectCount += m_objectCount;
+    s_totals.lineCount += m_lineCount;
+    s_totals.blockLayoutTime += blockLayoutTime();
+    s_totals.lineLayoutTime += lineLayoutTime();
+#endif
+}
+
+void LayoutStatistics::enterPhase(Phase phase)
+{
+    if (!m_phaseDepth[phase]++)
+        m_phaseStartTime[phase] = currentTime();
+}
+
+void LayoutStatistics::leavePhase(Phase phase)
+{
+    ASSERT(m_phaseDepth[phase]);
+    if (!--m_phaseDepth[phase])
+        m_phaseTime[phase] += currentTime() - m_phaseStartTime[phase];
+}
+
+} // namespace WebCore
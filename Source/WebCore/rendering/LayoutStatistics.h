@@ -0,0 +1,196 @@
+/*
+ * Copyright 2011, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LayoutStatistics_h
+#define LayoutStatistics_h
+
+#include <wtf/Noncopyable.h>
+
+namespace WebCore {
+
+class RenderObject;
+
+// Records what one FrameView::layout() pass did and what made it necessary.
+// Collection is only switched on while the inspector timeline is recording,
+// or always in ANDROID_INSTRUMENT builds, since timing block and line layout
+// reads the clock for every block.
+class LayoutStatistics {
+    WTF_MAKE_NONCOPYABLE(LayoutStatistics);
+public:
+    // The kind of change that first marked the tree for layout after the
+    // previous pass.
+    enum Trigger {
+        UnknownTrigger,
+        StyleChangeTrigger,
+        RenderTreeChangeTrigger,
+        TextChangeTrigger,
+        ResourceLoadTrigger,
+        ViewportChangeTrigger,
+        TriggerCount
+    };
+
+    static const char* triggerName(Trigger);
+
+    // Attributes the layouts scheduled while it is alive to the given trigger.
+    class TriggerScope {
+        WTF_MAKE_NONCOPYABLE(TriggerScope);
+    public:
+        TriggerScope(Trigger trigger)
+            : m_previousTrigger(s_currentTrigger)
+        {
+            s_currentTrigger = trigger;
+        }
+
+        ~TriggerScope() { s_currentTrigger = m_previousTrigger; }
+
+    private:
+        Trigger m_previousTrigger;
+    };
+
+    static Trigger currentTrigger() { return s_currentTrigger; }
+
+    enum Phase {
+        BlockLayoutPhase,
+        LineLayoutPhase,
+        PhaseCount
+    };
+
+    // Adds the time spent while it is alive to the given phase of the pass
+    // being collected. Nested scopes of the same phase are counted once.
+    class PhaseScope {
+        WTF_MAKE_NONCOPYABLE(PhaseScope);
+    public:
+        PhaseScope(Phase phase)
+            : m_statistics(s_current)
+            , m_phase(phase)
+        {
+            if (m_statistics)
+                m_statistics->enterPhase(phase);
+        }
+
+        ~PhaseScope()
+        {
+            if (m_statistics)
+                m_statistics->leavePhase(m_phase);
+        }
+
+    private:
+        LayoutStatistics* m_statistics;
+        Phase m_phase;
+    };
+
+    LayoutStatistics();
+
+    // The pass being collected, if any.
+    static LayoutStatistics* current() { return s_current; }
+
+    // A synchronous pass is one that ran before its layout timer fired,
+    // typically because script asked for style or geometry.
+    void start(RenderObject* root, bool isSubtree, Trigger, bool isSynchronous);
+    void stop();
+
+    bool wasCollected() const { return m_wasCollected; }
+
+    const char* rootName() const { return m_rootName; }
+    bool isSubtree() const { return m_isSubtree; }
+    Trigger trigger() const { return m_trigger; }
+    bool isSynchronous() const { return m_isSynchronous; }
+
+    // Objects whose layout was run, and how many of those were dirty
+    // themselves rather than only having dirty descendants.
+    unsigned objectCount() const { return m_objectCount; }
+    unsigned selfNeedsLayoutCount() const { return m_selfNeedsLayoutCount; }
+
+    unsigned lineCount() const { return m_lineCount; }
+    unsigned inlineBoxCount() const { return m_inlineBoxCount; }
+
+    // In seconds. Line layout includes the blocks laid out as part of lines,
+    // such as inline blocks and floats; block layout excludes line layout.
+    double totalTime() const { return m_totalTime; }
+    double blockLayoutTime() const { return m_phaseTime[BlockLayoutPhase] - m_phaseTime[LineLayoutPhase]; }
+    double lineLayoutTime() const { return m_phaseTime[LineLayoutPhase]; }
+
+    void didLayoutObject(bool selfNeededLayout)
+    {
+        ++m_objectCount;
+        if (selfNeededLayout)
+            ++m_selfNeedsLayoutCount;
+    }
+
+    void didCreateInlineBox(bool isRootLineBox)
+    {
+        ++m_inlineBoxCount;
+        if (isRootLineBox)
+            ++m_lineCount;
+    }
+
+#ifdef ANDROID_INSTRUMENT
+    // Sums over every collected pass, for the benchmark harness.
+    struct Totals {
+        unsigned passCount;
+        unsigned synchronousPassCount;
+        unsigned passCountByTrigger[TriggerCount];
+        unsigned objectCount;
+        unsigned lineCount;
+        double blockLayoutTime;
+        double lineLayoutTime;
+    };
+
+    static const Totals& totals() { return s_totals; }
+#endif
+
+private:
+    void enterPhase(Phase);
+    void leavePhase(Phase);
+
+    static LayoutStatistics* s_current;
+    static Trigger s_currentTrigger;
+#ifdef ANDROID_INSTRUMENT
+    static Totals s_totals;
+#endif
+
+    LayoutStatistics* m_previous;
+    bool m_wasCollected;
+
+    const char* m_rootName;
+    bool m_isSubtree;
+    Trigger m_trigger;
+    bool m_isSynchronous;
+
+    unsigned m_objectCount;
+    unsigned m_selfNeedsLayoutCount;
+    unsigned m_lineCount;
+    unsigned m_inlineBoxCount;
+
+    double m_startTime;
+    double m_totalTime;
+    unsigned m_phaseDepth[PhaseCount];
+    double m_phaseStartTime[PhaseCount];
+    double m_phaseTime[PhaseCount];
+};
+
+} // namespace WebCore
+
+#endif // LayoutStatistics_h
@@ -36,9 +36,16 @@
 #include "config.h"
 #include "RenderArena.h"
 
+#include "Arena.h"
 #include <stdlib.h>
 #include <string.h>
 #include <wtf/Assertions.h>
+#include <wtf/FastMalloc.h>
+#include <wtf/PageAllocationAligned.h>
+
+#ifdef ANDROID_INSTRUMENT
+#include <utils/Log.h>
+#endif
 
 #define ROUNDUP(x, y) ((((x)+((y)-1))/(y))*(y))
 
@@ -59,18 +66,96 @@ static const size_t debugHeaderSize = ARENA_ALIGN(sizeof(RenderArenaDebugHeader)
 
 #endif
 
-RenderArena::RenderArena(unsigned arenaSize)
+// Chunks are aligned to their size, so the chunk an object lives in is
+// found by masking the object's address.
+struct RenderArena::Chunk {
+    PageAllocationAligned allocation;
+    Chunk* previous;
+    Chunk* next;
+    unsigned liveCount;
+};
+
+static const size_t chunkSize = 16 * 1024;
+
+// Anything bigger than this would waste too much of a chunk and is
+// allocated on its own.
+static const size_t maxChunkObjectSize = chunkSize / 4;
+
+// trim() only walks the recyclers when at least this many chunks, and at
+// least a quarter of all chunks, are empty.
+static const unsigned minTrimmedChunkCount = 8;
+
+inline RenderArena::Chunk* RenderArena::chunkFor(void* ptr)
 {
-    // Initialize the arena pool
-    INIT_ARENA_POOL(&m_pool, "RenderArena", arenaSize);
+    return reinterpret_cast<Chunk*>(reinterpret_cast<uintptr_t>(ptr) & ~(chunkSize - 1));
+}
 
+RenderArena::RenderArena()
+    : m_chunks(0)
+    , m_currentChunk(0)
+    , m_available(0)
+    , m_limit(0)
+    , m_chunkCount(0)
+    , m_emptyChunkCount(0)
+#ifdef ANDROID_INSTRUMENT
+    , m_largeLiveCount(0)
+    , m_largeSize(0)
+#endif
+{
     // Zero out the recyclers array
     memset(m_recyclers, 0, sizeof(m_recyclers));
+#ifdef ANDROID_INSTRUMENT
+    memset(m_liveCounts, 0, sizeof(m_liveCounts));
+#endif
 }
 
 RenderArena::~RenderArena()
 {
-    FinishArenaPool(&m_pool);
+    while (m_chunks)
+        releaseChunk(m_chunks);
+}
+
+void RenderArena::startNewChunk()
+{
+    PageAllocationAligned allocation = PageAllocationAligned::allocate(chunkSize, chunkSize, OSAllocator::UnknownUsage);
+    if (!allocation)
+        CRASH();
+
+    Chunk* chunk = static_cast<Chunk*>(allocation.base());
+    ASSERT(chunkFor(chunk) == chunk);
+    chunk->allocation = allocation;
+    chunk->previous = 0;
+    chunk->next = m_chunks;
+    chunk->liveCount = 0;
+    if (m_chunks)
+        m_chunks->previous = chunk;
+    m_chunks = chunk;
+    ++m_chunkCount;
+    ++m_emptyChunkCount;
+
+    m_currentChunk = chunk;
+    m_available = reinterpret_cast<char*>(chunk) + ROUNDUP(sizeof(Chunk), sizeof(double));
+    m_limit = reinterpret_cast<char*>(chunk) + chunkSize;
+}
+
+void RenderArena::releaseChunk(Chunk* chunk)
+{
+    if (chunk->previous)
+        chunk->previous->next = chunk->next;
+    else
+        m_chunks = chunk->next;
+    if (chunk->next)
+        chunk->next->previous = chunk->previous;
+    if (chunk == m_currentChunk) {
+        m_currentChunk = 0;
+        m_available = 0;
+        m_limit = 0;
+    }
+    if (!chunk->liveCount)
+        --m_emptyChunkCount;
+    --m_chunkCount;
+
+    chunk->allocation.deallocate();
 }
 
 void* RenderArena::allocate(size_t size)
@@ -90,6 +175,14 @@ void* RenderArena::allocate(size_t size)
     // Ensure we have correct alignment for pointers.  Important for Tru64
     size = ROUNDUP(size, sizeof(void*));
 
+    if (size > maxChunkObjectSize) {
+#ifdef ANDROID_INSTRUMENT
+        ++m_largeLiveCount;
+        m_largeSize += size;
+#endif
+        return fastMalloc(size);
+    }
+
     // Check recyclers first
     if (size < gMaxRecycledSize) {
         const int index = size >> 2;
@@ -100,13 +193,22 @@ void* RenderArena::allocate(size_t size)
             void* next = *((void**)result);
             m_recyclers[index] = next;
         }
+#ifdef ANDROID_INSTRUMENT
+        ++m_liveCounts[index];
+#endif
     }
 
     if (!result) {
-        // Allocate a new chunk from the arena
-        ARENA_ALLOCATE(result, &m_pool, size);
+        // Carve a new object out of the current chunk
+        if (static_cast<size_t>(m_limit - m_available) < size)
+            startNewChunk();
+        result = m_available;
+        m_available += size;
     }
 
+    if (!chunkFor(result)->liveCount++)
+        --m_emptyChunkCount;
+
     return result;
 #endif
 }
@@ -126,20 +228,76 @@ void RenderArena::free(size_t size, void* ptr)
     // Ensure we have correct alignment for pointers.  Important for Tru64
     size = ROUNDUP(size, sizeof(void*));
 
+    if (size > maxChunkObjectSize) {
+#ifdef ANDROID_INSTRUMENT
+        --m_largeLiveCount;
+        m_largeSize -= size;
+#endif
+        fastFree(ptr);
+        return;
+    }
+
+    Chunk* chunk = chunkFor(ptr);
+    ASSERT(chunk->liveCount);
+    if (!--chunk->liveCount)
+        ++m_emptyChunkCount;
+
     // See if it's a size that we recycle
     if (size < gMaxRecycledSize) {
         const int index = size >> 2;
         void* currentTop = m_recyclers[index];
         m_recyclers[index] = ptr;
         *((void**)ptr) = currentTop;
+#ifdef ANDROID_INSTRUMENT
+        --m_liveCounts[index];
+#endif
     }
 #endif
 }
 
+void RenderArena::trim()
+{
+    if (m_emptyChunkCount < minTrimmedChunkCount || m_emptyChunkCount < m_chunkCount / 4)
+        return;
+
+    // The recycled objects in empty chunks have to go first. The current
+    // chunk is kept, since new objects are carved out of it.
+    for (size_t i = 0; i < gMaxRecycledSize >> 2; ++i) {
+        void** link = &m_recyclers[i];
+        while (void* recycled = *link) {
+            Chunk* chunk = chunkFor(recycled);
+            if (!chunk->liveCount && chunk != m_currentChunk)
+                *link = *static_cast<void**>(recycled);
+            else
+                link = static_cast<void**>(recycled);
+        }
+    }
+
+    Chunk* next;
+    for (Chunk* chunk = m_chunks; chunk; chunk = next) {
+        next = chunk->next;
+        if (!chunk->liveCount && chunk != m_currentChunk)
+            releaseChunk(chunk);
+    }
+}
+
 #ifdef ANDROID_INSTRUMENT
 size_t RenderArena::reportPoolSize() const
 {
-    return ReportPoolSize(&m_pool);
+    return m_chunkCount * chunkSize + m_largeSize;
+}
+
+void RenderArena::reportSizeClasses() const
+{
+    LOGD("Render arena: %d chunks of %d bytes, %d empty, %d large objects of %d bytes",
+        m_chunkCount, static_cast<int>(chunkSize), m_emptyChunkCount, m_largeLiveCount, static_cast<int>(m_largeSize));
+    for (size_t i = 0; i < gMaxRecycledSize >> 2; ++i) {
+        unsigned recycledCount = 0;
+        for (void* recycled = m_recyclers[i]; recycled; recycled = *static_cast<void**>(recycled))
+            ++recycledCount;
+        if (m_liveCounts[i] || recycledCount)
+            LOGD("Render arena size %d: %d live, %d recycled", static_cast<int>(i << 2), m_liveCounts[i], recycledCount);
+    }
 }
 #endif
 
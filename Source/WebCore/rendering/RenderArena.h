@@ -35,7 +35,6 @@
 #ifndef RenderArena_h
 #define RenderArena_h
 
-#include "Arena.h"
 #include <wtf/FastAllocBase.h>
 #include <wtf/Noncopyable.h>
 
@@ -46,24 +45,48 @@ static const size_t gMaxRecycledSize = 400;
 class RenderArena {
     WTF_MAKE_NONCOPYABLE(RenderArena); WTF_MAKE_FAST_ALLOCATED;
 public:
-    RenderArena(unsigned arenaSize = 4096);
+    RenderArena();
     ~RenderArena();
 
     // Memory management functions
     void* allocate(size_t);
     void free(size_t, void*);
 
+    // Gives the chunks that no longer hold live objects back to the system,
+    // once enough of them have emptied to be worth it. Removing a large part
+    // of the render tree leaves most of its chunks empty.
+    void trim();
+
 #ifdef ANDROID_INSTRUMENT
     size_t reportPoolSize() const;
+    void reportSizeClasses() const;
 #endif
 
 private:
-    // Underlying arena pool
-    ArenaPool m_pool;
+    struct Chunk;
+
+    static Chunk* chunkFor(void*);
+    void startNewChunk();
+    void releaseChunk(Chunk*);
+
+    // Chunks of live and recycled objects, and the unused tail of the
+    // current chunk that new objects are carved from.
+    Chunk* m_chunks;
+    Chunk* m_currentChunk;
+    char* m_available;
+    char* m_limit;
+    unsigned m_chunkCount;
+    unsigned m_emptyChunkCount;
 
     // The recycler array is sparse with the indices being multiples of 4,
     // i.e., 0, 4, 8, 12, 16, 20, ...
     void* m_recyclers[gMaxRecycledSize >> 2];
+
+#ifdef ANDROID_INSTRUMENT
+    unsigned m_liveCounts[gMaxRecycledSize >> 2];
+    unsigned m_largeLiveCount;
+    size_t m_largeSize;
+#endif
 };
 
 } // namespace WebCore
@@ -1175,6 +1175,8 @@ void RenderBlock::layoutBlock(bool relayoutChildren, int pageLogicalHeight)
     if (isInline() && !isInlineBlockOrInlineTable()) // Inline <form>s inside various table elements can
         return;                                      // cause us to come in here.  Just bail.
 
+    LayoutStatistics::PhaseScope statisticsScope(LayoutStatistics::BlockLayoutPhase);
+
     if (!relayoutChildren && simplifiedLayout())
         return;
 
@@ -1917,6 +1919,8 @@ void RenderBlock::layoutBlockChildren(bool relayoutChildren, int& maxFloatLogica
     // It doesn't get included in the normal layout process but is instead skipped.
     RenderObject* childToExclude = layoutSpecialExcludedChild(relayoutChildren);
 
+    computeBreakablePositionsForChildren();
+
     int previousFloatLogicalBottom = 0;
     maxFloatLogicalBottom = 0;
 
@@ -26,7 +26,9 @@
 #include "Hyphenation.h"
 #include "InlineIterator.h"
 #include "InlineTextBox.h"
+#include "LayoutStatistics.h"
 #include "Logging.h"
+#include "ParallelWorkerPool.h"
 #include "RenderArena.h"
 #include "RenderCombineText.h"
 #include "RenderInline.h"
@@ -174,6 +176,9 @@ void RenderBlock::appendRunsForObject(BidiRunList<BidiRun>& runs, int start, int
 
 static inline InlineBox* createInlineBoxForRenderer(RenderObject* obj, bool isRootLineBox, bool isOnlyRun = false)
 {
+    if (LayoutStatistics* statistics = LayoutStatistics::current())
+        statistics->didCreateInlineBox(isRootLineBox);
+
     if (isRootLineBox)
         return toRenderBlock(obj)->createAndAppendRootInlineBox();
     
@@ -729,8 +734,140 @@ void RenderBlock::appendFloatingObjectToLastLine(FloatingObject* floatingObject)
     lastRootBox()->appendFloat(floatingObject->renderer());
 }
 
+// Line break opportunities depend on neither fonts nor the available width.
+// Before a block lays out many paragraphs, they are found for all of them on
+// several threads, and line breaking reads them instead of scanning the text
+// again, in this layout and in later ones until the text changes. Measuring
+// text and building line boxes stay on the main thread, as fonts and their
+// glyph caches are main thread only.
+static const unsigned minimumCharactersForParallelLineBreaking = 16 * 1024;
+static const unsigned minimumCharactersPerLineBreakingThread = 4 * 1024;
+static const size_t maximumParallelLineBreakingThreads = 4;
+
+struct TextToBreak {
+    const UChar* characters;
+    int length;
+};
+
+struct BreakablePositionsJob {
+    const Vector<TextToBreak>* texts;
+    Vector<OwnPtr<BreakablePositions> >* results;
+    size_t start;
+    size_t end;
+};
+
+static size_t lineBreakingThreadCount()
+{
+#if OS(WINDOWS)
+    return 1;
+#else
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cores < 2)
+        return 1;
+    return min(static_cast<size_t>(cores), maximumParallelLineBreakingThreads);
+#endif
+}
+
+static void runBreakablePositionsJob(const BreakablePositionsJob& job)
+{
+#if USE(ICU_UNICODE)
+    // The shared line break iterator is main thread only, so the job opens
+    // its own the first time it needs one and moves it from text to text.
+    TextBreakIterator* iterator = 0;
+#endif
+    for (size_t i = job.start; i < job.end; ++i) {
+        const TextToBreak& text = job.texts->at(i);
+        if (!needsLineBreakIterator(text.characters, text.length)) {
+            (*job.results)[i] = adoptPtr(new BreakablePositions(text.characters, text.length, 0));
+            continue;
+        }
+#if USE(ICU_UNICODE)
+        if (!iterator)
+            iterator = openLineBreakIterator(text.characters, text.length);
+        else if (!setLineBreakIteratorText(iterator, text.characters, text.length))
+            continue;
+        if (iterator)
+            (*job.results)[i] = adoptPtr(new BreakablePositions(text.characters, text.length, iterator));
+#endif
+    }
+#if USE(ICU_UNICODE)
+    if (iterator)
+        closeLineBreakIterator(iterator);
+#endif
+}
+
+static void runBreakablePositionsJobFromPool(void* job)
+{
+    runBreakablePositionsJob(*static_cast<BreakablePositionsJob*>(job));
+}
+
+static ParallelWorkerPool& lineBreakingWorkers()
+{
+    // The main thread runs one job itself.
+    DEFINE_STATIC_LOCAL(ParallelWorkerPool, workers, ("WebCore: ParallelLineBreaking", maximumParallelLineBreakingThreads - 1));
+    return workers;
+}
+
+void RenderBlock::computeBreakablePositionsForChildren()
+{
+    Settings* settings = document()->settings();
+    if (!settings || !settings->parallelLineBreakingEnabled())
+        return;
+
+    size_t threadCount = lineBreakingThreadCount();
+    if (threadCount < 2)
+        return;
+
+    Vector<RenderText*> renderTexts;
+    Vector<TextToBreak> texts;
+    unsigned characterCount = 0;
+    for (RenderObject* child = firstChild(); child; child = child->nextSibling()) {
+        if (!child->isRenderBlock() || !child->childrenInline() || !child->needsLayout() || child->isFloatingOrPositioned())
+            continue;
+        for (RenderObject* o = child->firstChild(); o; o = o->nextInPreOrder(child)) {
+            if (!o->isText() || !o->style()->autoWrap())
+                continue;
+            RenderText* renderText = toRenderText(o);
+            if (renderText->breakablePositions() || !renderText->textLength())
+                continue;
+            TextToBreak text = { renderText->characters(), renderText->textLength() };
+            renderTexts.append(renderText);
+            texts.append(text);
+            characterCount += text.length;
+        }
+    }
+    if (characterCount < minimumCharactersForParallelLineBreaking)
+        return;
+    threadCount = min<size_t>(threadCount, characterCount / minimumCharactersPerLineBreakingThread);
+
+    Vector<OwnPtr<BreakablePositions> > results(texts.size());
+    Vector<BreakablePositionsJob, maximumParallelLineBreakingThreads> jobs;
+    unsigned charactersPerJob = (characterCount + threadCount - 1) / threadCount;
+    size_t start = 0;
+    while (start < texts.size()) {
+        size_t end = start;
+        unsigned jobCharacters = 0;
+        while (end < texts.size() && (jobCharacters < charactersPerJob || jobs.size() + 1 == threadCount))
+            jobCharacters += texts[end++].length;
+        BreakablePositionsJob job = { &texts, &results, start, end };
+        jobs.append(job);
+        start = end;
+    }
+
+    // This thread runs jobs too, and does not touch the render tree until
+    // all of them are done.
+    lineBreakingWorkers().run(runBreakablePositionsJobFromPool, jobs);
+
+    for (size_t i = 0; i < renderTexts.size(); ++i) {
+        if (results[i])
+            renderTexts[i]->setBreakablePositions(results[i].release());
+    }
+}
+
 void RenderBlock::layoutInlineChildren(bool relayoutChildren, int& repaintLogicalTop, int& repaintLogicalBottom)
 {
+    LayoutStatistics::PhaseScope statisticsScope(LayoutStatistics::LineLayoutPhase);
+
     bool useRepaintBounds = false;
     
     m_overflow.clear();
@@ -1635,6 +1772,15 @@ static bool shouldSkipWhitespaceAfterStartObject(RenderBlock* block, RenderObjec
     return false;
 }
 
+static inline bool isBreakable(RenderText* text, LazyLineBreakIterator& lazyBreakIterator, int pos, int& nextBreakable, bool breakNBSP)
+{
+    if (!breakNBSP) {
+        if (const BreakablePositions* positions = text->breakablePositions())
+            return isBreakable(*positions, pos, nextBreakable);
+    }
+    return isBreakable(lazyBreakIterator, pos, nextBreakable, breakNBSP);
+}
+
 static inline float textWidth(RenderText* text, unsigned from, unsigned len, const Font& font, float xPos, bool isFixedPitch, bool collapseWhiteSpace)
 {
     if (isFixedPitch || (!from && len == text->textLength()) || text->style()->hasTextCombine())
@@ -2075,7 +2221,7 @@ InlineIterator RenderBlock::findNextLineBreak(InlineBidiResolver& resolver, bool
                     lineBreakIteratorInfo.second.reset(str, strlen);
                 }
 
-                bool betweenWords = c == '\n' || (currWS != PRE && !atStart && isBreakable(lineBreakIteratorInfo.second, pos, nextBreakable, breakNBSP) && (style->hyphens() != HyphensNone || (pos && str[pos - 1] != softHyphen)));
+                bool betweenWords = c == '\n' || (currWS != PRE && !atStart && isBreakable(t, lineBreakIteratorInfo.second, pos, nextBreakable, breakNBSP) && (style->hyphens() != HyphensNone || (pos && str[pos - 1] != softHyphen)));
 
                 if (betweenWords || midWordBreak) {
                     bool stoppedIgnoringSpaces = false;
@@ -3263,6 +3263,29 @@ bool RenderBox::avoidsFloats() const
     return isReplaced() || hasOverflowClip() || isHR() || isLegend() || isWritingModeRoot();
 }
 
+bool RenderBox::logicalWidthIsUpToDate() const
+{
+    for (const RenderObject* object = this; object; object = object->parent()) {
+        if (object->selfNeedsLayout())
+            return false;
+        if (object->isRenderView())
+            return true;
+
+        // Floats, positioned objects, inline blocks, table parts and flexible
+        // box children all take their width from their content or siblings.
+        // Boxes that avoid floats take it from the floats around them.
+        if (!object->isRenderBlock() || !object->isBlockFlow() || object->isInline() || object->isFloatingOrPositioned()
+            || object->isTableCell() || object->parent()->isFlexibleBox())
+            return false;
+        const RenderBox* box = toRenderBox(object);
+        if (box->avoidsFloats() || box->hasColumns() || box->stretchesToMinIntrinsicLogicalWidth()
+            || box->sizesToIntrinsicLogicalWidth(LogicalWidth) || box->sizesToIntrinsicLogicalWidth(MinLogicalWidth)
+            || box->sizesToIntrinsicLogicalWidth(MaxLogicalWidth))
+            return false;
+    }
+    return false;
+}
+
 void RenderBox::addShadowOverflow()
 {
     int shadowLeft;
@@ -375,6 +375,12 @@ public:
     bool shrinkToAvoidFloats() const;
     virtual bool avoidsFloats() const;
 
+    // Whether the logical width is already what the next layout would give
+    // it, however dirty the rest of the tree is. This holds when the width
+    // follows from the box's own style and its containing block's width
+    // alone, all the way up to the view, and none of those boxes is dirty.
+    bool logicalWidthIsUpToDate() const;
+
     virtual void markForPaginationRelayoutIfNeeded() { }
 
     bool isWritingModeRoot() const { return !parent() || parent()->style()->writingMode() != style()->writingMode(); }
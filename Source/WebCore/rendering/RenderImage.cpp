@@ -35,6 +35,7 @@
 #include "HTMLMapElement.h"
 #include "HTMLNames.h"
 #include "HitTestResult.h"
+#include "LayoutStatistics.h"
 #include "Page.h"
 #include "RenderLayer.h"
 #include "RenderView.h"
@@ -139,6 +140,8 @@ void RenderImage::imageChanged(WrappedImagePtr newImage, const IntRect* rect)
     if (documentBeingDestroyed())
         return;
 
+    LayoutStatistics::TriggerScope triggerScope(LayoutStatistics::ResourceLoadTrigger);
+
     if (hasBoxDecorations() || hasMask())
         RenderReplaced::imageChanged(newImage, rect);
     
@@ -40,6 +40,7 @@
 #include "HTMLIFrameElement.h"
 #include "HTMLNames.h"
 #include "HitTestResult.h"
+#include "IntPointHash.h"
 #include "NodeList.h"
 #include "Page.h"
 #include "RenderApplet.h"
@@ -104,6 +105,119 @@ struct CompositingState {
 #endif
 };
 
+// The bounds of the layers that later layers in paint order are tested
+// against. Each rect is filed under the cells of a coarse grid that it
+// touches, so a test only looks at the layers near the tested rect rather
+// than at every layer added so far.
+class RenderLayerCompositor::OverlapMap {
+    WTF_MAKE_NONCOPYABLE(OverlapMap);
+public:
+    OverlapMap() { }
+
+    bool isEmpty() const { return m_layers.isEmpty(); }
+
+    void add(const RenderLayer* layer, const IntRect& bounds)
+    {
+        // A layer keeps the bounds it was first added with.
+        if (!m_layers.add(layer).second)
+            return;
+
+        CellRange cells(bounds);
+        if (cells.count() > maxCellsPerRect) {
+            m_largeRects.append(bounds);
+            return;
+        }
+
+        for (int y = cells.minY; y <= cells.maxY; ++y) {
+            for (int x = cells.minX; x <= cells.maxX; ++x)
+                m_cells.add(IntPoint(x, y), Vector<IntRect>()).first->second.append(bounds);
+        }
+    }
+
+    bool overlaps(const IntRect& bounds) const
+    {
+        for (size_t i = 0; i < m_largeRects.size(); ++i) {
+            if (bounds.intersects(m_largeRects[i]))
+                return true;
+        }
+
+        CellRange cells(bounds);
+        if (cells.count() > static_cast<unsigned>(m_cells.size())) {
+            // Cheaper to look at every occupied cell.
+            CellMap::const_iterator end = m_cells.end();
+            for (CellMap::const_iterator it = m_cells.begin(); it != end; ++it) {
+                if (cells.contains(it->first) && intersectsAny(bounds, it->second))
+                    return true;
+            }
+            return false;
+        }
+
+        for (int y = cells.minY; y <= cells.maxY; ++y) {
+            for (int x = cells.minX; x <= cells.maxX; ++x) {
+                CellMap::const_iterator it = m_cells.find(IntPoint(x, y));
+                if (it != m_cells.end() && intersectsAny(bounds, it->second))
+                    return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    static const int cellSize = 256;
+
+    // Rects spanning more cells than this, such as page-sized layers, are
+    // kept in a list of their own and tested against every time.
+    static const unsigned maxCellsPerRect = 64;
+
+    struct CellRange {
+        CellRange(const IntRect& bounds)
+            : minX(cellIndex(bounds.x()))
+            , minY(cellIndex(bounds.y()))
+            , maxX(cellIndex(bounds.maxX() - 1))
+            , maxY(cellIndex(bounds.maxY() - 1))
+        {
+        }
+
+        unsigned count() const
+        {
+            unsigned width = maxX - minX + 1;
+            unsigned height = maxY - minY + 1;
+            if (width > maxCellsPerRect || height > maxCellsPerRect)
+                return std::numeric_limits<unsigned>::max();
+            return width * height;
+        }
+
+        bool contains(const IntPoint& cell) const
+        {
+            return cell.x() >= minX && cell.x() <= maxX && cell.y() >= minY && cell.y() <= maxY;
+        }
+
+        int minX;
+        int minY;
+        int maxX;
+        int maxY;
+    };
+
+    static int cellIndex(int coordinate)
+    {
+        return coordinate >= 0 ? coordinate / cellSize : (coordinate + 1) / cellSize - 1;
+    }
+
+    static bool intersectsAny(const IntRect& bounds, const Vector<IntRect>& rects)
+    {
+        for (size_t i = 0; i < rects.size(); ++i) {
+            if (bounds.intersects(rects[i]))
+                return true;
+        }
+        return false;
+    }
+
+    typedef HashMap<IntPoint, Vector<IntRect> > CellMap;
+    CellMap m_cells;
+    Vector<IntRect> m_largeRects;
+    HashSet<const RenderLayer*> m_layers;
+};
+
 RenderLayerCompositor::RenderLayerCompositor(RenderView* renderView)
     : m_renderView(renderView)
     , m_rootPlatformLayer(0)
@@ -600,15 +714,7 @@ void RenderLayerCompositor::addToOverlapMap(OverlapMap& overlapMap, RenderLayer*
 
 bool RenderLayerCompositor::overlapsCompositedLayers(OverlapMap& overlapMap, const IntRect& layerBounds)
 {
-    RenderLayerCompositor::OverlapMap::const_iterator end = overlapMap.end();
-    for (RenderLayerCompositor::OverlapMap::const_iterator it = overlapMap.begin(); it != end; ++it) {
-        const IntRect& bounds = it->second;
-        if (layerBounds.intersects(bounds)) {
-            return true;
-        }
-    }
-    
-    return false;
+    return overlapMap.overlaps(layerBounds);
 }
 
 #if ENABLE(COMPOSITED_FIXED_ELEMENTS)
@@ -30,6 +30,7 @@
 #include "Document.h"
 #include "Element.h"
 #include "FloatQuad.h"
+#include "LayoutStatistics.h"
 #include "PaintPhase.h"
 #include "RenderObjectChildList.h"
 #include "RenderStyle.h"
@@ -930,6 +931,10 @@ inline void RenderObject::setNeedsLayout(bool b, bool markParents)
                 setLayerNeedsFullRepaint();
         }
     } else {
+        if (LayoutStatistics* statistics = LayoutStatistics::current()) {
+            if (alreadyNeededLayout || m_normalChildNeedsLayout || m_posChildNeedsLayout || m_needsSimplifiedNormalFlowLayout || m_needsPositionedMovementLayout)
+                statistics->didLayoutObject(alreadyNeededLayout);
+        }
         m_everHadLayout = true;
         m_posChildNeedsLayout = false;
         m_needsSimplifiedNormalFlowLayout = false;
@@ -29,6 +29,7 @@
 
 #include "AXObjectCache.h"
 #include "ContentData.h"
+#include "LayoutStatistics.h"
 #include "RenderBlock.h"
 #include "RenderCounter.h"
 #include "RenderImage.h"
@@ -65,6 +66,8 @@ RenderObject* RenderObjectChildList::removeChildNode(RenderObject* owner, Render
 {
     ASSERT(oldChild->parent() == owner);
 
+    LayoutStatistics::TriggerScope triggerScope(LayoutStatistics::RenderTreeChangeTrigger);
+
     // So that we'll get the appropriate dirty bit set (either that a normal flow child got yanked or
     // that a positioned child got yanked).  We also repaint, so that the area exposed when the child
     // disappears gets repainted properly.
@@ -143,6 +146,8 @@ void RenderObjectChildList::appendChildNode(RenderObject* owner, RenderObject* n
     ASSERT(newChild->parent() == 0);
     ASSERT(!owner->isBlockFlow() || (!newChild->isTableSection() && !newChild->isTableRow() && !newChild->isTableCell()));
 
+    LayoutStatistics::TriggerScope triggerScope(LayoutStatistics::RenderTreeChangeTrigger);
+
     newChild->setParent(owner);
     RenderObject* lChild = lastChild();
 
@@ -196,6 +201,9 @@ void RenderObjectChildList::insertChildNode(RenderObject* owner, RenderObject* c
     }
 
     ASSERT(!child->parent());
+
+    LayoutStatistics::TriggerScope triggerScope(LayoutStatistics::RenderTreeChangeTrigger);
+
     while (beforeChild->parent() != owner && beforeChild->parent()->isAnonymousBlock())
         beforeChild = beforeChild->parent();
     ASSERT(beforeChild->parent() == owner);
@@ -840,6 +840,15 @@ void RenderTable::recalcSections() const
     ASSERT(selfNeedsLayout());
 
     m_needsSectionRecalc = false;
+
+    if (m_tableLayout)
+        m_tableLayout->cellGridChanged();
+}
+
+void RenderTable::cellPreferredLogicalWidthsDirtied(RenderTableCell* cell)
+{
+    if (m_tableLayout)
+        m_tableLayout->cellPreferredLogicalWidthsDirtied(cell);
 }
 
 int RenderTable::calcBorderStart() const
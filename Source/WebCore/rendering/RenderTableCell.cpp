@@ -87,6 +87,15 @@ void RenderTableCell::updateFromElement()
     }
 }
 
+void RenderTableCell::preferredLogicalWidthsDirtied()
+{
+    RenderObject* row = parent();
+    RenderObject* section = row ? row->parent() : 0;
+    RenderObject* table = section ? section->parent() : 0;
+    if (table && table->isTable())
+        toRenderTable(table)->cellPreferredLogicalWidthsDirtied(this);
+}
+
 Length RenderTableCell::styleOrColLogicalWidth() const
 {
     Length w = style()->logicalWidth();
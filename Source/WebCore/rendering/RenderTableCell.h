@@ -53,6 +53,9 @@ public:
 
     Length styleOrColLogicalWidth() const;
 
+    // Lets the table layout know which column needs its widths recomputed.
+    void preferredLogicalWidthsDirtied();
+
     virtual void computePreferredLogicalWidths();
 
     void updateLogicalWidth(int);
@@ -31,6 +31,7 @@
 #include "FontTranscoder.h"
 #include "FrameView.h"
 #include "InlineTextBox.h"
+#include "LayoutStatistics.h"
 #include "Range.h"
 #include "RenderArena.h"
 #include "RenderBlock.h"
@@ -1125,6 +1126,7 @@ void RenderText::setTextInternal(PassRefPtr<StringImpl> text)
 {
     ASSERT(text);
     m_text = text;
+    m_breakablePositions.clear();
     if (m_needsTranscoding) {
         const TextEncoding* encoding = document()->decoder() ? &document()->decoder()->encoding() : 0;
         fontTranscoder().convert(m_text, style()->font().fontDescription(), encoding);
@@ -1164,7 +1166,10 @@ void RenderText::setText(PassRefPtr<StringImpl> text, bool force)
         return;
 
     setTextInternal(text);
-    setNeedsLayoutAndPrefWidthsRecalc();
+    {
+        LayoutStatistics::TriggerScope triggerScope(LayoutStatistics::TextChangeTrigger);
+        setNeedsLayoutAndPrefWidthsRecalc();
+    }
     m_knownToHaveNoOverflowAndNoFallbackFonts = false;
     
     AXObjectCache* axObjectCache = document()->axObjectCache();
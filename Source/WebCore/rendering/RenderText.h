@@ -24,7 +24,10 @@
 #define RenderText_h
 
 #include "RenderObject.h"
+#include "break_lines.h"
 #include <wtf/Forward.h>
+#include <wtf/OwnPtr.h>
+#include <wtf/PassOwnPtr.h>
 
 namespace WebCore {
 
@@ -69,6 +72,11 @@ public:
 
     const UChar* characters() const { return m_text.characters(); }
     unsigned textLength() const { return m_text.length(); } // non virtual implementation of length()
+
+    // Line break opportunities precomputed for line layout, if any. They are
+    // dropped whenever the text changes.
+    const BreakablePositions* breakablePositions() const { return m_breakablePositions.get(); }
+    void setBreakablePositions(PassOwnPtr<BreakablePositions> positions) { m_breakablePositions = positions; }
     void positionLineBox(InlineBox*);
 
     virtual float width(unsigned from, unsigned len, const Font&, float xPos, HashSet<const SimpleFontData*>* fallbackFonts = 0, GlyphOverflow* = 0) const;
@@ -170,6 +178,8 @@ private:
     float m_beginMinWidth;
     float m_endMinWidth;
 
+    OwnPtr<BreakablePositions> m_breakablePositions;
+
     bool m_hasBreakableChar : 1; // Whether or not we can be broken into multiple lines.
     bool m_hasBreak : 1; // Whether or not we have a hard break (e.g., <pre> with '\n').
     bool m_hasTab : 1; // Whether or not we have a variable width tab character (e.g., <pre> with '\t').
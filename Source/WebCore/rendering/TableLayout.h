@@ -27,6 +27,7 @@
 namespace WebCore {
 
 class RenderTable;
+class RenderTableCell;
 
 class TableLayout {
     WTF_MAKE_NONCOPYABLE(TableLayout); WTF_MAKE_FAST_ALLOCATED;
@@ -41,6 +42,11 @@ public:
     virtual void computePreferredLogicalWidths(int& minWidth, int& maxWidth) = 0;
     virtual void layout() = 0;
 
+    // Called when the preferred logical widths of a cell become dirty, and
+    // when the table has rebuilt its grid of cells.
+    virtual void cellPreferredLogicalWidthsDirtied(RenderTableCell*) { }
+    virtual void cellGridChanged() { }
+
 protected:
     RenderTable* m_table;
 };
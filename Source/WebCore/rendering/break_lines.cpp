@@ -158,10 +158,9 @@ static inline TextBreakLocatorRef lineBreakLocator()
 }
 #endif
 
-int nextBreakablePosition(LazyLineBreakIterator& lazyBreakIterator, int pos, bool treatNoBreakSpaceAsBreak)
+template<typename LineBreakIterator>
+static inline int nextBreakablePosition(LineBreakIterator& lazyBreakIterator, const UChar* str, int len, int pos, bool treatNoBreakSpaceAsBreak)
 {
-    const UChar* str = lazyBreakIterator.string();
-    int len = lazyBreakIterator.length();
     int nextBreak = -1;
 
     UChar lastCh = pos > 0 ? str[pos - 1] : 0;
@@ -196,4 +195,63 @@ int nextBreakablePosition(LazyLineBreakIterator& lazyBreakIterator, int pos, boo
     return len;
 }
 
+int nextBreakablePosition(LazyLineBreakIterator& lazyBreakIterator, int pos, bool treatNoBreakSpaceAsBreak)
+{
+    return nextBreakablePosition(lazyBreakIterator, lazyBreakIterator.string(), lazyBreakIterator.length(), pos, treatNoBreakSpaceAsBreak);
+}
+
+// Hands the shared nextBreakablePosition() an iterator its caller owns.
+class OwnedLineBreakIterator {
+public:
+    explicit OwnedLineBreakIterator(TextBreakIterator* iterator) : m_iterator(iterator) { }
+    TextBreakIterator* get() const { return m_iterator; }
+
+private:
+    TextBreakIterator* m_iterator;
+};
+
+static const int bitsPerWord = sizeof(unsigned) * 8;
+
+BreakablePositions::BreakablePositions(const UChar* string, int length, TextBreakIterator* iterator)
+    : m_length(length)
+{
+    // Vector leaves the words of a POD type uninitialized.
+    m_bits.fill(0, (length + bitsPerWord - 1) / bitsPerWord);
+    OwnedLineBreakIterator ownedIterator(iterator);
+    int pos = 0;
+    while (pos < length) {
+        int breakable = nextBreakablePosition(ownedIterator, string, length, pos, false);
+        if (breakable >= length)
+            break;
+        m_bits[breakable / bitsPerWord] |= 1u << (breakable % bitsPerWord);
+        pos = breakable + 1;
+    }
+}
+
+int BreakablePositions::next(int pos) const
+{
+    if (pos >= m_length)
+        return m_length;
+    size_t word = pos / bitsPerWord;
+    unsigned bits = m_bits[word] & (~0u << (pos % bitsPerWord));
+    while (!bits) {
+        if (++word == m_bits.size())
+            return m_length;
+        bits = m_bits[word];
+    }
+    int bit = 0;
+    while (!(bits & (1u << bit)))
+        ++bit;
+    return word * bitsPerWord + bit;
+}
+
+bool needsLineBreakIterator(const UChar* string, int length)
+{
+    for (int i = 0; i < length; ++i) {
+        if (needsLineBreakIterator(string[i]))
+            return true;
+    }
+    return false;
+}
+
 } // namespace WebCore
@@ -21,11 +21,15 @@
 #ifndef break_lines_h
 #define break_lines_h
 
+#include <wtf/FastAllocBase.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/Vector.h>
 #include <wtf/unicode/Unicode.h>
 
 namespace WebCore {
 
 class LazyLineBreakIterator;
+struct TextBreakIterator;
 
 int nextBreakablePosition(LazyLineBreakIterator&, int pos, bool breakNBSP = false);
 
@@ -36,6 +40,34 @@ inline bool isBreakable(LazyLineBreakIterator& lazyBreakIterator, int pos, int&
     return pos == nextBreakable;
 }
 
+// All the positions in a string at which isBreakable() returns true when
+// no-break spaces are not break opportunities. They do not depend on the
+// available width, so they can be computed once, on any thread, and kept
+// across layouts.
+class BreakablePositions {
+    WTF_MAKE_NONCOPYABLE(BreakablePositions); WTF_MAKE_FAST_ALLOCATED;
+public:
+    // |iterator| must be a line break iterator over the string that the
+    // calling thread owns, or 0 if no character in it needs one.
+    BreakablePositions(const UChar*, int length, TextBreakIterator*);
+
+    // Same result as nextBreakablePosition() with breakNBSP false.
+    int next(int pos) const;
+
+private:
+    int m_length;
+    Vector<unsigned> m_bits;
+};
+
+inline bool isBreakable(const BreakablePositions& positions, int pos, int& nextBreakable)
+{
+    if (pos > nextBreakable)
+        nextBreakable = positions.next(pos);
+    return pos == nextBreakable;
+}
+
+bool needsLineBreakIterator(const UChar*, int length);
+
 } // namespace WebCore
 
 #endif // break_lines_h
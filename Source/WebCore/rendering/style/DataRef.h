@@ -48,6 +48,13 @@ public:
         m_data = T::create();
     }
 
+    // Shares an equal instance instead of the current data.
+    void replaceWithEqual(PassRefPtr<T> data)
+    {
+        ASSERT(*data == *m_data);
+        m_data = data;
+    }
+
     bool operator==(const DataRef<T>& o) const
     {
         ASSERT(m_data);
@@ -320,6 +320,14 @@ public:
     ~RenderStyle();
 
     void inheritFrom(const RenderStyle* inheritParent);
+    void copyNonInheritedFrom(const RenderStyle*);
+
+    // A fast check that only looks at whether the inherited data is shared.
+    bool inheritedDataShared(const RenderStyle*) const;
+
+    // Shares the common data groups with other styles that have equal ones.
+    // Meant for styles that are done being resolved; later changes unshare.
+    void internData();
 
     PseudoId styleType() const { return static_cast<PseudoId>(noninherited_flags._styleType); }
     void setStyleType(PseudoId styleType) { noninherited_flags._styleType = styleType; }
@@ -38,6 +38,7 @@
 #include "StyleBackgroundData.cpp"
 #include "StyleBoxData.cpp"
 #include "StyleCachedImage.cpp"
+#include "StyleDataInterner.cpp"
 #include "StyleFlexibleBoxData.cpp"
 #include "StyleGeneratedImage.cpp"
 #include "StyleInheritedData.cpp"
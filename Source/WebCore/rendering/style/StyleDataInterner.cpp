@@ -0,0 +1,272 @@
+/*
+ * Copyright 2011, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "StyleDataInterner.h"
+
+#include "StyleBackgroundData.h"
+#include "StyleBoxData.h"
+#include "StyleInheritedData.h"
+#include "StyleSurroundData.h"
+#include "StyleVisualData.h"
+#include <wtf/HashSet.h>
+#include <wtf/StdLibExtras.h>
+#include <wtf/Vector.h>
+
+#ifdef ANDROID_INSTRUMENT
+#include <utils/Log.h>
+#endif
+
+using namespace std;
+
+namespace WebCore {
+
+// The hashes only look at the fields that usually tell groups apart.
+// Anything equal by operator== must hash the same.
+
+static inline void addToHash(unsigned& hash, unsigned value)
+{
+    hash = hash * 31 + value;
+}
+
+static inline void addToHash(unsigned& hash, const Length& length)
+{
+    addToHash(hash, length.type());
+    addToHash(hash, length.value());
+}
+
+static inline void addToHash(unsigned& hash, const LengthBox& box)
+{
+    addToHash(hash, box.left());
+    addToHash(hash, box.right());
+    addToHash(hash, box.top());
+    addToHash(hash, box.bottom());
+}
+
+static unsigned computeHash(const StyleBoxData& data)
+{
+    unsigned hash = 0;
+    addToHash(hash, data.width());
+    addToHash(hash, data.height());
+    addToHash(hash, data.minWidth());
+    addToHash(hash, data.maxWidth());
+    addToHash(hash, data.minHeight());
+    addToHash(hash, data.maxHeight());
+    addToHash(hash, data.verticalAlign());
+    addToHash(hash, data.zIndex());
+    return hash;
+}
+
+static unsigned computeHash(const StyleVisualData& data)
+{
+    unsigned hash = data.textDecoration;
+    addToHash(hash, data.clip);
+    return hash;
+}
+
+static unsigned computeHash(const StyleBackgroundData& data)
+{
+    unsigned hash = data.color().rgb();
+    addToHash(hash, data.background().image() ? 1 : 0);
+    addToHash(hash, data.outline().style());
+    return hash;
+}
+
+static unsigned computeHash(const StyleSurroundData& data)
+{
+    unsigned hash = 0;
+    addToHash(hash, data.margin);
+    addToHash(hash, data.padding);
+    addToHash(hash, data.offset);
+    return hash;
+}
+
+static unsigned computeHash(const StyleInheritedData& data)
+{
+    unsigned hash = data.color.rgb();
+    addToHash(hash, data.line_height);
+    addToHash(hash, data.font.pixelSize());
+    addToHash(hash, data.horizontal_border_spacing);
+    addToHash(hash, data.vertical_border_spacing);
+    return hash;
+}
+
+template <typename T> struct StyleDataHash {
+    static unsigned hash(const RefPtr<T>& data) { return computeHash(*data); }
+    static bool equal(const RefPtr<T>& a, const RefPtr<T>& b) { return a == b || *a == *b; }
+    static const bool safeToCompareToEmptyOrDeleted = false;
+};
+
+template <typename T> class StyleDataTable {
+    WTF_MAKE_NONCOPYABLE(StyleDataTable);
+public:
+    // Below this size the table is never purged.
+    static const unsigned minimumPurgeSize = 256;
+
+    explicit StyleDataTable(const char* name)
+        : m_name(name)
+        , m_purgeSize(minimumPurgeSize)
+#ifdef ANDROID_INSTRUMENT
+        , m_lookupCount(0)
+        , m_hitCount(0)
+#endif
+    {
+    }
+
+    void intern(DataRef<T>& data)
+    {
+        std::pair<typename Table::iterator, bool> result = m_table.add(const_cast<T*>(data.get()));
+        if (result.second) {
+            // Every entry is kept alive by the table, so the table can only
+            // grow without bound if nothing is ever purged.
+            if (static_cast<unsigned>(m_table.size()) >= m_purgeSize) {
+                purge();
+                m_purgeSize = max<unsigned>(minimumPurgeSize, m_table.size() * 2);
+            }
+        } else if (result.first->get() != data.get())
+            data.replaceWithEqual(*result.first);
+#ifdef ANDROID_INSTRUMENT
+        ++m_lookupCount;
+        if (!result.second)
+            ++m_hitCount;
+#endif
+    }
+
+    void purge()
+    {
+        Vector<T*> unused;
+        typename Table::iterator end = m_table.end();
+        for (typename Table::iterator it = m_table.begin(); it != end; ++it) {
+            if ((*it)->hasOneRef())
+                unused.append(it->get());
+        }
+        for (size_t i = 0; i < unused.size(); ++i)
+            m_table.remove(unused[i]);
+    }
+
+#ifdef ANDROID_INSTRUMENT
+    void report() const
+    {
+        // Every style sharing an entry beyond the first is an allocation saved.
+        // The table holds one reference of its own.
+        unsigned savedCount = 0;
+        typename Table::const_iterator end = m_table.end();
+        for (typename Table::const_iterator it = m_table.begin(); it != end; ++it) {
+            if ((*it)->refCount() > 2)
+                savedCount += (*it)->refCount() - 2;
+        }
+        LOGD("Style %s data: %d lookups, %d hits, %d entries of %d bytes, %d bytes saved",
+            m_name, m_lookupCount, m_hitCount, m_table.size(), static_cast<int>(sizeof(T)), static_cast<int>(savedCount * sizeof(T)));
+    }
+#endif
+
+private:
+    typedef HashSet<RefPtr<T>, StyleDataHash<T> > Table;
+
+    const char* m_name;
+    Table m_table;
+    unsigned m_purgeSize;
+#ifdef ANDROID_INSTRUMENT
+    unsigned m_lookupCount;
+    unsigned m_hitCount;
+#endif
+};
+
+static StyleDataTable<StyleBoxData>& boxDataTable()
+{
+    DEFINE_STATIC_LOCAL(StyleDataTable<StyleBoxData>, table, ("box"));
+    return table;
+}
+
+static StyleDataTable<StyleVisualData>& visualDataTable()
+{
+    DEFINE_STATIC_LOCAL(StyleDataTable<StyleVisualData>, table, ("visual"));
+    return table;
+}
+
+static StyleDataTable<StyleBackgroundData>& backgroundDataTable()
+{
+    DEFINE_STATIC_LOCAL(StyleDataTable<StyleBackgroundData>, table, ("background"));
+    return table;
+}
+
+static StyleDataTable<StyleSurroundData>& surroundDataTable()
+{
+    DEFINE_STATIC_LOCAL(StyleDataTable<StyleSurroundData>, table, ("surround"));
+    return table;
+}
+
+static StyleDataTable<StyleInheritedData>& inheritedDataTable()
+{
+    DEFINE_STATIC_LOCAL(StyleDataTable<StyleInheritedData>, table, ("inherited"));
+    return table;
+}
+
+void StyleDataInterner::intern(DataRef<StyleBoxData>& data)
+{
+    boxDataTable().intern(data);
+}
+
+void StyleDataInterner::intern(DataRef<StyleVisualData>& data)
+{
+    visualDataTable().intern(data);
+}
+
+void StyleDataInterner::intern(DataRef<StyleBackgroundData>& data)
+{
+    backgroundDataTable().intern(data);
+}
+
+void StyleDataInterner::intern(DataRef<StyleSurroundData>& data)
+{
+    surroundDataTable().intern(data);
+}
+
+void StyleDataInterner::intern(DataRef<StyleInheritedData>& data)
+{
+    inheritedDataTable().intern(data);
+}
+
+void StyleDataInterner::purge()
+{
+    boxDataTable().purge();
+    visualDataTable().purge();
+    backgroundDataTable().purge();
+    surroundDataTable().purge();
+    inheritedDataTable().purge();
+}
+
+#ifdef ANDROID_INSTRUMENT
+void StyleDataInterner::report()
+{
+    boxDataTable().report();
+    visualDataTable().report();
+    backgroundDataTable().report();
+    surroundDataTable().report();
+    inheritedDataTable().report();
+}
+#endif
+
+} // namespace WebCore
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2011, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef StyleDataInterner_h
+#define StyleDataInterner_h
+
+#include "DataRef.h"
+
+namespace WebCore {
+
+class StyleBackgroundData;
+class StyleBoxData;
+class StyleInheritedData;
+class StyleSurroundData;
+class StyleVisualData;
+
+// Lets equal style data groups resolved independently for different
+// elements share one allocation. Each table keeps a reference to the data
+// it hands out, so shared data is never modified in place: DataRef::access()
+// copies it first, like any other data with more than one owner.
+class StyleDataInterner {
+public:
+    // Replaces the data with an equal instance seen before, if there is one,
+    // and otherwise remembers it for later styles.
+    static void intern(DataRef<StyleBoxData>&);
+    static void intern(DataRef<StyleVisualData>&);
+    static void intern(DataRef<StyleBackgroundData>&);
+    static void intern(DataRef<StyleSurroundData>&);
+    static void intern(DataRef<StyleInheritedData>&);
+
+    // Forgets the data no style uses any more.
+    static void purge();
+
+#ifdef ANDROID_INSTRUMENT
+    static void report();
+#endif
+};
+
+} // namespace WebCore
+
+#endif // StyleDataInterner_h
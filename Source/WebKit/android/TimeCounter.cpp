@@ -30,9 +30,12 @@
 
 #include "MemoryCache.h"
 #include "KURL.h"
+#include "LayoutStatistics.h"
 #include "Node.h"
 #include "SystemTime.h"
 #include "StyleBase.h"
+#include "StyleDataInterner.h"
+#include "WidthCache.h"
 #include <sys/time.h>
 #include <time.h>
 #include <utils/Log.h>
@@ -41,6 +44,7 @@
 
 #if USE(JSC)
 #include "JSDOMWindow.h"
+#include <jit/ExecutableAllocator.h>
 #include <runtime/JSGlobalObject.h>
 #include <runtime/JSLock.h>
 #endif
@@ -142,9 +146,25 @@ void TimeCounter::report(const KURL& url, int live, int dead, size_t arenaSize)
     Heap::Statistics jsHeapStatistics = JSDOMWindow::commonJSGlobalData()->heap.statistics();
     LOGD("Current JavaScript heap size is %d and has %d bytes free",
             jsHeapStatistics.size, jsHeapStatistics.free);
+#if ENABLE(ASSEMBLER)
+    ExecutableAllocator::Statistics jitStatistics = ExecutableAllocator::statistics();
+    LOGD("Current JIT code uses %d of %d reserved bytes in %d allocations, %d free runs, largest %d bytes",
+            jitStatistics.committedBytes, jitStatistics.reservedBytes, jitStatistics.allocationCount,
+            jitStatistics.freeBlockCount, jitStatistics.largestFreeBlockBytes);
+#endif
 #endif
     LOGD("Current CSS styles use %d bytes", StyleBase::reportStyleSize());
+    StyleDataInterner::report();
     LOGD("Current DOM nodes use %d bytes", WebCore::Node::reportDOMNodesSize());
+    LOGD("Word width cache: %d hits, %d misses", WidthCache::hitCount(), WidthCache::missCount());
+    const LayoutStatistics::Totals& layout = LayoutStatistics::totals();
+    LOGD("Layout: %d passes (%d forced), %d objects, %d lines, block %d ms, line %d ms",
+        layout.passCount, layout.synchronousPassCount, layout.objectCount, layout.lineCount,
+        static_cast<int>(layout.blockLayoutTime * 1000), static_cast<int>(layout.lineLayoutTime * 1000));
+    for (int i = 0; i < LayoutStatistics::TriggerCount; i++) {
+        LayoutStatistics::Trigger trigger = static_cast<LayoutStatistics::Trigger>(i);
+        LOGD("Layout triggered by %s: %d passes", LayoutStatistics::triggerName(trigger), layout.passCountByTrigger[i]);
+    }
 }
 
 void TimeCounter::reportNow()
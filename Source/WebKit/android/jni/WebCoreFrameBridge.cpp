@@ -75,6 +75,7 @@
 #include "SecurityOrigin.h"
 #include "SelectionController.h"
 #include "Settings.h"
+#include "StyleDataInterner.h"
 #include "SubstituteData.h"
 #include "UrlInterceptResponse.h"
 #include "UserGestureIndicator.h"
@@ -1922,6 +1923,9 @@ static void ClearWebCoreCache()
     WebCore::pageCache()->setCapacity(0);
     WebCore::pageCache()->releaseAutoreleasedPagesNow();
     WebCore::pageCache()->setCapacity(pageCapacity);
+
+    // Drop the shared style data of the pages just released.
+    WebCore::StyleDataInterner::purge();
 }
 
 static void ClearWebViewCache()
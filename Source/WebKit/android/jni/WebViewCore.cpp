@@ -114,6 +114,7 @@
 #include "SkCanvas.h"
 #include "SkPicture.h"
 #include "SkUtils.h"
+#include "StyleDataInterner.h"
 #include "Text.h"
 #include "TypingCommand.h"
 #include "WebCache.h"
@@ -4543,6 +4544,9 @@ static void FreeMemory(JNIEnv* env, jobject obj)
     SkANP::InitEvent(&event, kLifecycle_ANPEventType);
     event.data.lifecycle.action = kFreeMemory_ANPLifecycleAction;
     GET_NATIVE_VIEW(env, obj)->sendPluginEvent(event);
+
+    // The interned style data keeps its images and fonts alive.
+    WebCore::StyleDataInterner::purge();
 }
 
 static void ProvideVisitedHistory(JNIEnv *env, jobject obj, jobject hist)